@@ -0,0 +1,423 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+/*
+ * Host-only microbenchmarks for the pipeline building blocks. Every result is
+ * printed as one CSV line on stdout so that runs of different releases can be
+ * compared with standard tools:
+ *
+ *      benchmark,variant,items,item_bytes,ns_per_item,items_per_second,bytes_per_second
+ *
+ * Build (no CUDA required):
+ *      g++ -std=c++14 -O2 -pthread -Iinclude bench/pipeline.cpp -o pipeline_bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <glados/pipeline/input_side.h>
+#include <glados/pipeline/output_side.h>
+#include <glados/pipeline/pipeline.h>
+#include <glados/pipeline/stage.h>
+#include <glados/pipeline/task_queue.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct item
+    {
+        std::vector<unsigned char> payload;
+        bool valid;
+    };
+
+    // stage<> treats a leading std::size_t as the input limit, so the source is configured through a struct
+    struct workload
+    {
+        std::size_t items;
+        std::size_t bytes;
+    };
+
+    class source
+    {
+        public:
+            using input_type = void;
+            using output_type = item;
+
+        public:
+            source(workload w) noexcept
+            : count_{w.items}, bytes_{w.bytes}
+            {}
+
+            auto run() -> void
+            {
+                for(auto i = std::size_t{0}; i < count_; ++i)
+                    output_(item{std::vector<unsigned char>(bytes_), true});
+
+                output_(item{{}, false});
+            }
+
+            auto set_output_function(std::function<void(output_type)> f) noexcept -> void
+            {
+                output_ = f;
+            }
+
+        private:
+            std::size_t count_;
+            std::size_t bytes_;
+            std::function<void(output_type)> output_;
+    };
+
+    class relay
+    {
+        public:
+            using input_type = item;
+            using output_type = item;
+
+        public:
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto i = input_();
+                    auto valid = i.valid;
+
+                    // touch the payload once so that the item size matters
+                    if(!i.payload.empty())
+                        ++i.payload.front();
+
+                    output_(std::move(i));
+
+                    if(!valid)
+                        break;
+                }
+            }
+
+            auto set_input_function(std::function<input_type(void)> f) noexcept -> void
+            {
+                input_ = f;
+            }
+
+            auto set_output_function(std::function<void(output_type)> f) noexcept -> void
+            {
+                output_ = f;
+            }
+
+        private:
+            std::function<input_type(void)> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    class sink
+    {
+        public:
+            using input_type = item;
+            using output_type = void;
+
+        public:
+            sink(std::size_t producers = 1) noexcept
+            : producers_{producers}
+            {}
+
+            auto run() -> void
+            {
+                auto finished = std::size_t{0};
+                while(finished < producers_)
+                {
+                    auto i = input_();
+                    if(!i.valid)
+                        ++finished;
+                }
+            }
+
+            auto set_input_function(std::function<input_type(void)> f) noexcept -> void
+            {
+                input_ = f;
+            }
+
+        private:
+            std::size_t producers_;
+            std::function<input_type(void)> input_;
+    };
+
+    struct task
+    {
+        std::size_t id;
+    };
+
+    class task_stage
+    {
+        public:
+            auto run() -> void
+            {
+                checksum_ += task_.id;
+            }
+
+            auto assign_task(task t) noexcept -> void
+            {
+                task_ = t;
+            }
+
+            auto checksum() const noexcept -> std::size_t
+            {
+                return checksum_;
+            }
+
+        private:
+            task task_;
+            std::size_t checksum_ = 0;
+    };
+
+    auto report(const std::string& benchmark, const std::string& variant, std::size_t items, std::size_t item_bytes,
+                clock_type::duration elapsed) -> void
+    {
+        auto seconds = std::chrono::duration<double>{elapsed}.count();
+        auto ns_per_item = seconds * 1e9 / static_cast<double>(items);
+        auto items_per_second = static_cast<double>(items) / seconds;
+        auto bytes_per_second = items_per_second * static_cast<double>(item_bytes);
+
+        std::printf("%s,%s,%zu,%zu,%.1f,%.1f,%.1f\n", benchmark.c_str(), variant.c_str(), items, item_bytes,
+                    ns_per_item, items_per_second, bytes_per_second);
+        std::fflush(stdout);
+    }
+
+    template <class F>
+    auto best_of(std::size_t repetitions, F&& f) -> clock_type::duration
+    {
+        auto best = clock_type::duration::max();
+        for(auto r = std::size_t{0}; r < repetitions; ++r)
+        {
+            auto start = clock_type::now();
+            f();
+            best = std::min(best, clock_type::now() - start);
+        }
+        return best;
+    }
+
+    /* raw cost of output_side::output + input_side::take on a single thread */
+    auto bench_side_overhead(std::size_t items) -> void
+    {
+        auto in = glados::pipeline::input_side<item>{};
+        auto out = glados::pipeline::output_side<item>{};
+        out.attach(&in);
+
+        auto elapsed = best_of(3, [&]()
+        {
+            for(auto i = std::size_t{0}; i < items; ++i)
+            {
+                out.output(item{{}, true});
+                auto t = in.take();
+                static_cast<void>(t);
+            }
+        });
+
+        report("side_overhead", "output+take", items, 0, elapsed);
+    }
+
+    /* source -> sink through the stage wrappers, one thread per stage */
+    auto bench_stage_overhead(std::size_t items) -> void
+    {
+        auto elapsed = best_of(3, [&]()
+        {
+            auto p = glados::pipeline::pipeline{};
+            auto src = p.make_stage<source>(workload{items, 0});
+            auto snk = p.make_stage<sink>();
+            p.connect(src, snk);
+            p.run(src, snk);
+            p.wait();
+        });
+
+        report("stage_overhead", "source->sink", items, 0, elapsed);
+    }
+
+    /* throughput against the number of relay stages and the payload size */
+    auto bench_chain(std::size_t items, std::size_t length, std::size_t bytes) -> void
+    {
+        using relay_stage = glados::pipeline::stage<relay>;
+
+        auto elapsed = best_of(3, [&]()
+        {
+            auto p = glados::pipeline::pipeline{};
+            auto src = p.make_stage<source>(workload{items, bytes});
+            auto snk = p.make_stage<sink>();
+
+            auto relays = std::vector<std::unique_ptr<relay_stage>>{};
+            for(auto i = std::size_t{0}; i < length; ++i)
+                relays.emplace_back(new relay_stage{});
+
+            if(relays.empty())
+                p.connect(src, snk);
+            else
+            {
+                p.connect(src, *relays.front());
+                for(auto i = std::size_t{1}; i < relays.size(); ++i)
+                    p.connect(*relays[i - 1], *relays[i]);
+                p.connect(*relays.back(), snk);
+            }
+
+            p.run(src, snk);
+            for(auto&& r : relays)
+                p.run(*r);
+            p.wait();
+        });
+
+        report("chain", "stages=" + std::to_string(length), items, bytes, elapsed);
+    }
+
+    /* many producers feeding a single input_side */
+    auto bench_fan_in(std::size_t items, std::size_t producers) -> void
+    {
+        using source_stage = glados::pipeline::stage<source>;
+
+        auto per_producer = items / producers;
+        auto elapsed = best_of(3, [&]()
+        {
+            auto p = glados::pipeline::pipeline{};
+            auto snk = p.make_stage<sink>(std::size_t{0}, producers);
+
+            auto sources = std::vector<std::unique_ptr<source_stage>>{};
+            for(auto i = std::size_t{0}; i < producers; ++i)
+            {
+                sources.emplace_back(new source_stage{workload{per_producer, 0}});
+                p.connect(*sources.back(), snk);
+            }
+
+            p.run(snk);
+            for(auto&& s : sources)
+                p.run(*s);
+            p.wait();
+        });
+
+        report("fan_in", "producers=" + std::to_string(producers), per_producer * producers, 0, elapsed);
+    }
+
+    /* a single producer distributing round-robin to several consumers */
+    auto bench_fan_out(std::size_t items, std::size_t consumers) -> void
+    {
+        using sink_stage = glados::pipeline::stage<sink>;
+
+        auto elapsed = best_of(3, [&]()
+        {
+            auto sinks = std::vector<std::unique_ptr<sink_stage>>{};
+            auto outputs = std::vector<glados::pipeline::output_side<item>>(consumers);
+            auto threads = std::vector<std::thread>{};
+
+            for(auto i = std::size_t{0}; i < consumers; ++i)
+            {
+                sinks.emplace_back(new sink_stage{});
+                outputs[i].attach(sinks.back().get());
+                threads.emplace_back(&sink_stage::run, sinks.back().get());
+            }
+
+            for(auto i = std::size_t{0}; i < items; ++i)
+                outputs[i % consumers].output(item{{}, true});
+
+            for(auto&& o : outputs)
+                o.output(item{{}, false});
+
+            for(auto&& t : threads)
+                t.join();
+        });
+
+        report("fan_out", "consumers=" + std::to_string(consumers), items, 0, elapsed);
+    }
+
+    // task_pipeline::run() starts execution after the last stage, so the stages are passed at once
+    template <class TaskPipeline, std::size_t... Is>
+    auto run_stages(TaskPipeline& tp, std::vector<task_stage>& w, std::index_sequence<Is...>) -> void
+    {
+        tp.run(w[Is]...);
+    }
+
+    /* time needed by task_pipeline to switch from one task to the next */
+    template <std::size_t Stages>
+    auto bench_task_switch(std::size_t tasks) -> void
+    {
+        auto elapsed = best_of(3, [&]()
+        {
+            auto q = std::queue<task>{};
+            for(auto i = std::size_t{0}; i < tasks; ++i)
+                q.push(task{i});
+
+            glados::pipeline::task_queue<task> tq{q};
+            auto tp = glados::pipeline::task_pipeline<task>{&tq};
+            auto w = std::vector<task_stage>(Stages);
+
+            run_stages(tp, w, std::make_index_sequence<Stages>{});
+            tp.wait();
+
+            // every stage has to see every task
+            for(auto&& s : w)
+            {
+                if(s.checksum() != tasks * (tasks - 1) / 2)
+                {
+                    std::fprintf(stderr, "task_switch: stage missed tasks\n");
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+        });
+
+        report("task_switch", "stages=" + std::to_string(Stages), tasks, 0, elapsed);
+    }
+}
+
+auto main(int argc, char** argv) -> int
+{
+    // an optional scale factor allows quick smoke runs and long, stable runs
+    auto scale = (argc > 1) ? std::strtod(argv[1], nullptr) : 1.0;
+    if(scale <= 0.0)
+        scale = 1.0;
+
+    auto scaled = [scale](std::size_t n) { return std::max(std::size_t{1}, static_cast<std::size_t>(static_cast<double>(n) * scale)); };
+
+    std::printf("benchmark,variant,items,item_bytes,ns_per_item,items_per_second,bytes_per_second\n");
+
+    bench_side_overhead(scaled(1000000));
+    bench_stage_overhead(scaled(200000));
+
+    for(auto length : {0u, 1u, 2u, 4u, 8u})
+        bench_chain(scaled(50000), length, 64);
+
+    for(auto bytes : {64u, 4096u, 65536u, 1048576u})
+        bench_chain(scaled(bytes >= 65536u ? 2000 : 20000), 2, bytes);
+
+    for(auto n : {1u, 2u, 4u, 8u})
+        bench_fan_in(scaled(200000), n);
+
+    for(auto n : {1u, 2u, 4u, 8u})
+        bench_fan_out(scaled(200000), n);
+
+    bench_task_switch<1>(scaled(2000));
+    bench_task_switch<4>(scaled(2000));
+
+    return EXIT_SUCCESS;
+}
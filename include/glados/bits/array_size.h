@@ -0,0 +1,66 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_ARRAY_SIZE_H_
+#define GLADOS_BITS_ARRAY_SIZE_H_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Products of extents and element sizes, checked like new T[n]: a result
+         * which does not fit into std::size_t throws std::bad_array_new_length
+         * instead of wrapping around to a small allocation.
+         */
+        inline auto array_size(std::size_t a, std::size_t b) -> std::size_t
+        {
+            if(b != 0 && a > std::numeric_limits<std::size_t>::max() / b)
+                throw std::bad_array_new_length{};
+            return a * b;
+        }
+
+        inline auto array_size(std::size_t a, std::size_t b, std::size_t c) -> std::size_t
+        {
+            return array_size(array_size(a, b), c);
+        }
+
+        inline auto array_size(std::size_t a, std::size_t b, std::size_t c, std::size_t d) -> std::size_t
+        {
+            return array_size(array_size(a, b, c), d);
+        }
+
+        /* bytes + extra, throws std::bad_array_new_length on overflow */
+        inline auto padded_size(std::size_t bytes, std::size_t extra) -> std::size_t
+        {
+            if(bytes > std::numeric_limits<std::size_t>::max() - extra)
+                throw std::bad_array_new_length{};
+            return bytes + extra;
+        }
+    }
+}
+
+#endif /* GLADOS_BITS_ARRAY_SIZE_H_ */
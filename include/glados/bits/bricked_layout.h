@@ -0,0 +1,234 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_BITS_BRICKED_LAYOUT_H_
+#define GLADOS_BITS_BRICKED_LAYOUT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace glados
+{
+    enum class brick_order
+    {
+        linear, // x fastest inside a brick
+        morton  // Z-order inside a brick
+    };
+
+    namespace detail
+    {
+        /* spreads the lower 21 bits of v so that two zero bits follow every bit */
+        inline auto spread_bits(std::uint64_t v) noexcept -> std::uint64_t
+        {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffull;
+            v = (v | v << 16) & 0x1f0000ff0000ffull;
+            v = (v | v << 8) & 0x100f00f00f00f00full;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+            v = (v | v << 2) & 0x1249249249249249ull;
+            return v;
+        }
+
+        inline auto morton_encode(std::size_t x, std::size_t y, std::size_t z) noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>(spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2));
+        }
+    }
+
+    /*
+     * Index computation for a 3D volume stored as Brick x Brick x Brick bricks.
+     * The bricks are arranged in z-y-x order; inside a brick the elements are
+     * stored row by row or in Z-order. The volume is padded to whole bricks,
+     * so size() may exceed x * y * z.
+     */
+    template <std::size_t Brick = 8, brick_order Order = brick_order::linear>
+    class bricked_layout
+    {
+        static_assert(Brick != 0 && (Brick & (Brick - 1)) == 0, "The brick size must be a power of two");
+
+        public:
+            static constexpr auto brick_size = Brick;
+            static constexpr auto brick_volume = Brick * Brick * Brick;
+            static constexpr auto order = Order;
+
+        public:
+            bricked_layout() noexcept
+            : x_{0}, y_{0}, z_{0}, bx_{0}, by_{0}, bz_{0}
+            {}
+
+            bricked_layout(std::size_t x, std::size_t y, std::size_t z) noexcept
+            : x_{x}, y_{y}, z_{z}, bx_{bricks(x)}, by_{bricks(y)}, bz_{bricks(z)}
+            {}
+
+            /* number of elements including the padding */
+            auto size() const noexcept -> std::size_t
+            {
+                return bx_ * by_ * bz_ * brick_volume;
+            }
+
+            auto index(std::size_t x, std::size_t y, std::size_t z) const noexcept -> std::size_t
+            {
+                auto brick = ((z / Brick) * by_ + (y / Brick)) * bx_ + (x / Brick);
+                return brick * brick_volume + offset(x % Brick, y % Brick, z % Brick, std::integral_constant<bool, Order == brick_order::morton>{});
+            }
+
+            auto x() const noexcept -> std::size_t { return x_; }
+            auto y() const noexcept -> std::size_t { return y_; }
+            auto z() const noexcept -> std::size_t { return z_; }
+
+            auto bricks_x() const noexcept -> std::size_t { return bx_; }
+            auto bricks_y() const noexcept -> std::size_t { return by_; }
+            auto bricks_z() const noexcept -> std::size_t { return bz_; }
+
+        private:
+            static auto bricks(std::size_t n) noexcept -> std::size_t
+            {
+                return (n + Brick - 1) / Brick;
+            }
+
+            static auto offset(std::size_t x, std::size_t y, std::size_t z, std::false_type) noexcept -> std::size_t
+            {
+                return (z * Brick + y) * Brick + x;
+            }
+
+            static auto offset(std::size_t x, std::size_t y, std::size_t z, std::true_type) noexcept -> std::size_t
+            {
+                return detail::morton_encode(x, y, z);
+            }
+
+        private:
+            std::size_t x_, y_, z_;
+            std::size_t bx_, by_, bz_;
+    };
+
+    /* element access to bricked memory, does not own the data */
+    template <class T, std::size_t Brick = 8, brick_order Order = brick_order::linear>
+    class bricked_view
+    {
+        public:
+            using element_type = T;
+            using layout_type = bricked_layout<Brick, Order>;
+
+        public:
+            bricked_view(T* data, std::size_t x, std::size_t y, std::size_t z) noexcept
+            : data_{data}, layout_{x, y, z}
+            {}
+
+            bricked_view(T* data, layout_type layout) noexcept
+            : data_{data}, layout_(layout)
+            {}
+
+            /* views of T convert to views of const T */
+            template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            bricked_view(const bricked_view<U, Brick, Order>& other) noexcept
+            : data_{other.data()}, layout_(other.layout())
+            {}
+
+            auto operator()(std::size_t x, std::size_t y, std::size_t z) const noexcept -> T&
+            {
+                return data_[layout_.index(x, y, z)];
+            }
+
+            auto data() const noexcept -> T* { return data_; }
+            auto layout() const noexcept -> const layout_type& { return layout_; }
+
+        private:
+            T* data_;
+            layout_type layout_;
+    };
+
+    namespace detail
+    {
+        /*
+         * Visits the volume brick by brick and calls f(x, y, z, n, bricked_offset)
+         * for every run of n elements which are contiguous in both layouts.
+         */
+        template <std::size_t Brick, brick_order Order, class F>
+        auto for_each_brick_row(const bricked_layout<Brick, Order>& l, F&& f) -> void
+        {
+            for(auto bz = std::size_t{0}; bz < l.bricks_z(); ++bz)
+            for(auto by = std::size_t{0}; by < l.bricks_y(); ++by)
+            for(auto bx = std::size_t{0}; bx < l.bricks_x(); ++bx)
+            {
+                auto x0 = bx * Brick;
+                auto z_end = std::min(l.z(), (bz + 1) * Brick);
+                auto y_end = std::min(l.y(), (by + 1) * Brick);
+                auto n = std::min(l.x(), x0 + Brick) - x0;
+
+                for(auto z = bz * Brick; z < z_end; ++z)
+                for(auto y = by * Brick; y < y_end; ++y)
+                {
+                    if(Order == brick_order::linear)
+                        f(x0, y, z, n, l.index(x0, y, z));
+                    else
+                    {
+                        for(auto x = x0; x < x0 + n; ++x)
+                            f(x, y, z, std::size_t{1}, l.index(x, y, z));
+                    }
+                }
+            }
+        }
+    }
+
+    /* copies a linear volume with the given row pitch (in bytes) into bricked memory */
+    template <class T, std::size_t Brick, brick_order Order>
+    auto copy_to_bricked(const bricked_view<T, Brick, Order>& dst, const T* src, std::size_t src_pitch) -> void
+    {
+        auto bytes = reinterpret_cast<const unsigned char*>(src);
+        auto rows = dst.layout().y();
+        detail::for_each_brick_row(dst.layout(), [&](std::size_t x, std::size_t y, std::size_t z, std::size_t n, std::size_t idx)
+        {
+            auto row = reinterpret_cast<const T*>(bytes + (z * rows + y) * src_pitch);
+            std::copy_n(row + x, n, dst.data() + idx);
+        });
+    }
+
+    template <class T, std::size_t Brick, brick_order Order>
+    auto copy_to_bricked(const bricked_view<T, Brick, Order>& dst, const T* src) -> void
+    {
+        copy_to_bricked(dst, src, dst.layout().x() * sizeof(T));
+    }
+
+    /* copies bricked memory into a linear volume with the given row pitch (in bytes) */
+    template <class T, class U, std::size_t Brick, brick_order Order>
+    auto copy_to_linear(U* dst, std::size_t dst_pitch, const bricked_view<T, Brick, Order>& src) -> void
+    {
+        auto bytes = reinterpret_cast<unsigned char*>(dst);
+        auto rows = src.layout().y();
+        detail::for_each_brick_row(src.layout(), [&](std::size_t x, std::size_t y, std::size_t z, std::size_t n, std::size_t idx)
+        {
+            auto row = reinterpret_cast<U*>(bytes + (z * rows + y) * dst_pitch);
+            std::copy_n(src.data() + idx, n, row + x);
+        });
+    }
+
+    template <class T, class U, std::size_t Brick, brick_order Order>
+    auto copy_to_linear(U* dst, const bricked_view<T, Brick, Order>& src) -> void
+    {
+        copy_to_linear(dst, src.layout().x() * sizeof(U), src);
+    }
+}
+
+#endif /* GLADOS_BITS_BRICKED_LAYOUT_H_ */
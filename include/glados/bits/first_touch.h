@@ -0,0 +1,95 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_FIRST_TOUCH_H_
+#define GLADOS_BITS_FIRST_TOUCH_H_
+
+#include <cstddef>
+#include <type_traits>
+
+#include <unistd.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * True for allocators which return private anonymous memory, i.e. memory
+         * whose contents are not observed before the first write. Allocators opt
+         * in by declaring static constexpr bool anonymous_memory = true.
+         */
+        template <class Alloc, class = void>
+        struct has_anonymous_memory : std::false_type {};
+
+        template <class Alloc>
+        struct has_anonymous_memory<Alloc, typename std::enable_if<Alloc::anonymous_memory>::type> : std::true_type {};
+
+        /* writes one byte per page */
+        inline auto touch_pages(volatile unsigned char* bp, std::size_t bytes, std::true_type) noexcept -> void
+        {
+            static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            for(auto i = std::size_t{0}; i < bytes; i += page)
+                bp[i] = 0;
+            bp[bytes - 1] = 0;
+        }
+
+        /* reads one byte per page */
+        inline auto touch_pages(volatile unsigned char* bp, std::size_t bytes, std::false_type) noexcept -> void
+        {
+            static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            auto sink = static_cast<unsigned char>(0);
+            for(auto i = std::size_t{0}; i < bytes; i += page)
+                sink ^= bp[i];
+            sink ^= bp[bytes - 1];
+            static_cast<void>(sink);
+        }
+
+        /*
+         * Faults the whole buffer in now (on the calling thread's NUMA node)
+         * instead of on first use. Pages are written to only if Alloc hands out
+         * anonymous memory and T is trivially default constructible; constructed
+         * objects and file-backed memory are only read, which still maps them.
+         * Only plain host pointers are touched; other pointer types (device
+         * memory, pitched pointers) are left alone.
+         */
+        template <class Alloc, class T>
+        auto first_touch(T* p, std::size_t bytes, std::true_type) noexcept -> void
+        {
+            if(p == nullptr || bytes == 0)
+                return;
+
+            using write = std::integral_constant<bool, has_anonymous_memory<Alloc>::value
+                                                       && std::is_trivially_default_constructible<T>::value>;
+            touch_pages(reinterpret_cast<volatile unsigned char*>(p), bytes, write{});
+        }
+
+        template <class Alloc, class Pointer>
+        auto first_touch(const Pointer&, std::size_t, std::false_type) noexcept -> void
+        {}
+
+        template <class Alloc, class Pointer>
+        auto first_touch(const Pointer&, std::size_t, std::true_type) noexcept -> void
+        {}
+    }
+}
+
+#endif /* GLADOS_BITS_FIRST_TOUCH_H_ */
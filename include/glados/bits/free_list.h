@@ -0,0 +1,273 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_FREE_LIST_H_
+#define GLADOS_BITS_FREE_LIST_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Lock-free LIFO of idle buffers. Nodes are addressed by index and are
+         * never returned to the system before the list is destroyed, so a thread
+         * may safely read a node which another thread has popped in the meantime;
+         * the stack heads carry a tag which is incremented on every update to
+         * rule out ABA. Nodes which do not hold a buffer are kept on a second
+         * stack, so push() and pop() do not allocate once the list has seen as
+         * many buffers as there are in flight. add_spare() allows the owner to
+         * create that node up front, together with the buffer.
+         */
+        template <class Pointer>
+        class free_list
+        {
+            private:
+                static constexpr auto nil = std::uint32_t{0};
+                static constexpr auto first_chunk = std::size_t{64};
+                static constexpr auto max_chunks = std::size_t{26};
+
+                struct node
+                {
+                    std::atomic<std::uint32_t> next{nil};
+                    typename std::aligned_storage<sizeof(Pointer), alignof(Pointer)>::type storage;
+
+                    auto value() noexcept -> Pointer* { return reinterpret_cast<Pointer*>(&storage); }
+                };
+
+                /* head word: upper 32 bits tag, lower 32 bits node index + 1 */
+                using head_type = std::uint64_t;
+
+            public:
+                free_list() noexcept
+                : free_{0}, spare_{0}, size_{0}, nodes_{0}
+                {
+                    for(auto&& c : chunks_)
+                        c.store(nullptr, std::memory_order_relaxed);
+                }
+
+                /* not thread-safe, like the move operations of the owning pool */
+                free_list(free_list&& other) noexcept
+                : free_list{}
+                {
+                    steal(other);
+                }
+
+                auto operator=(free_list&& other) noexcept -> free_list&
+                {
+                    clear();
+                    steal(other);
+                    return *this;
+                }
+
+                free_list(const free_list&) = delete;
+                auto operator=(const free_list&) -> free_list& = delete;
+
+                ~free_list()
+                {
+                    clear();
+                }
+
+                auto push(const Pointer& p) noexcept -> bool
+                {
+                    auto idx = pop_index(spare_);
+                    if(idx == nil)
+                    {
+                        idx = new_node();
+                        if(idx == nil)
+                            return false;
+                    }
+
+                    auto n = at(idx);
+                    ::new(static_cast<void*>(&n->storage)) Pointer(p);
+                    size_.fetch_add(1, std::memory_order_relaxed);
+                    push_index(free_, idx);
+                    return true;
+                }
+
+                auto pop(Pointer& p) noexcept -> bool
+                {
+                    auto idx = pop_index(free_);
+                    if(idx == nil)
+                        return false;
+
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    auto n = at(idx);
+                    p = std::move(*n->value());
+                    n->value()->~Pointer();
+                    push_index(spare_, idx);
+                    return true;
+                }
+
+                /* creates one empty node so that a later push() does not need to allocate */
+                auto add_spare() noexcept -> void
+                {
+                    auto idx = new_node();
+                    if(idx != nil)
+                        push_index(spare_, idx);
+                }
+
+                /* approximate under concurrent modification */
+                auto size() const noexcept -> std::size_t
+                {
+                    return size_.load(std::memory_order_relaxed);
+                }
+
+                auto empty() const noexcept -> bool
+                {
+                    return size() == 0;
+                }
+
+                /* pops every buffer and hands it to f */
+                template <class F>
+                auto drain(F&& f) noexcept(noexcept(f(std::declval<Pointer&>()))) -> void
+                {
+                    auto p = Pointer{nullptr};
+                    while(pop(p))
+                        f(p);
+                }
+
+            private:
+                static auto index_of(head_type h) noexcept -> std::uint32_t
+                {
+                    return static_cast<std::uint32_t>(h);
+                }
+
+                static auto make_head(head_type old, std::uint32_t idx) noexcept -> head_type
+                {
+                    return (((old >> 32) + 1) << 32) | idx;
+                }
+
+                /* chunk k holds first_chunk << k nodes */
+                static auto chunk_of(std::size_t i) noexcept -> std::size_t
+                {
+                    auto q = static_cast<unsigned long long>(i / first_chunk + 1);
+                    return static_cast<std::size_t>(63 - __builtin_clzll(q));
+                }
+
+                static auto chunk_begin(std::size_t k) noexcept -> std::size_t
+                {
+                    return first_chunk * ((std::size_t{1} << k) - 1);
+                }
+
+                auto at(std::uint32_t idx) const noexcept -> node*
+                {
+                    auto i = static_cast<std::size_t>(idx - 1);
+                    auto k = chunk_of(i);
+                    return chunks_[k].load(std::memory_order_acquire) + (i - chunk_begin(k));
+                }
+
+                auto push_index(std::atomic<head_type>& head, std::uint32_t idx) noexcept -> void
+                {
+                    auto n = at(idx);
+                    auto old = head.load(std::memory_order_relaxed);
+                    do
+                    {
+                        n->next.store(index_of(old), std::memory_order_relaxed);
+                    } while(!head.compare_exchange_weak(old, make_head(old, idx), std::memory_order_release, std::memory_order_relaxed));
+                }
+
+                auto pop_index(std::atomic<head_type>& head) noexcept -> std::uint32_t
+                {
+                    auto old = head.load(std::memory_order_acquire);
+                    while(index_of(old) != nil)
+                    {
+                        auto next = at(index_of(old))->next.load(std::memory_order_relaxed);
+                        if(head.compare_exchange_weak(old, make_head(old, next), std::memory_order_acquire, std::memory_order_acquire))
+                            return index_of(old);
+                    }
+                    return nil;
+                }
+
+                /* slow path, taken once per buffer the pool ever creates */
+                auto new_node() noexcept -> std::uint32_t
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{grow_mutex_};
+
+                    auto i = nodes_;
+                    auto k = chunk_of(i);
+                    if(k >= max_chunks)
+                        return nil;
+
+                    if(chunks_[k].load(std::memory_order_relaxed) == nullptr)
+                    {
+                        auto c = new(std::nothrow) node[first_chunk << k];
+                        if(c == nullptr)
+                            return nil;
+                        chunks_[k].store(c, std::memory_order_release);
+                    }
+
+                    ++nodes_;
+                    return static_cast<std::uint32_t>(i + 1);
+                }
+
+                auto clear() noexcept -> void
+                {
+                    auto p = Pointer{nullptr};
+                    while(pop(p)) {}
+
+                    for(auto&& c : chunks_)
+                    {
+                        delete[] c.load(std::memory_order_relaxed);
+                        c.store(nullptr, std::memory_order_relaxed);
+                    }
+
+                    free_.store(0, std::memory_order_relaxed);
+                    spare_.store(0, std::memory_order_relaxed);
+                    nodes_ = 0;
+                }
+
+                auto steal(free_list& other) noexcept -> void
+                {
+                    for(auto k = std::size_t{0}; k < max_chunks; ++k)
+                    {
+                        chunks_[k].store(other.chunks_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                        other.chunks_[k].store(nullptr, std::memory_order_relaxed);
+                    }
+
+                    free_.store(other.free_.exchange(0), std::memory_order_relaxed);
+                    spare_.store(other.spare_.exchange(0), std::memory_order_relaxed);
+                    size_.store(other.size_.exchange(0), std::memory_order_relaxed);
+                    nodes_ = other.nodes_;
+                    other.nodes_ = 0;
+                }
+
+            private:
+                std::atomic<head_type> free_;
+                std::atomic<head_type> spare_;
+                std::atomic<std::size_t> size_;
+
+                std::mutex grow_mutex_;
+                std::size_t nodes_;
+                std::atomic<node*> chunks_[max_chunks];
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_FREE_LIST_H_ */
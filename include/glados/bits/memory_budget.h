@@ -0,0 +1,219 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_BITS_MEMORY_BUDGET_H_
+#define GLADOS_BITS_MEMORY_BUDGET_H_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <new>
+
+namespace glados
+{
+    /*
+     * Node-wide memory cap shared by several pools and queues. Every
+     * participant charges the bytes it holds with acquire() and returns them
+     * with release(). Requests that do not fit wait in FIFO order, so a large
+     * request is not starved by a stream of small ones.
+     *
+     * Pools with idle buffers register a reclaimer. When the first waiter
+     * does not fit, the reclaimers are asked to free (and release()) about the
+     * missing number of bytes, so idle capacity flows to whoever needs it.
+     * Reclaimers are called without the budget's lock held; they must not
+     * call acquire().
+     */
+    class memory_budget
+    {
+        private:
+            using lock_type = std::unique_lock<std::mutex>;
+
+        public:
+            using clock_type = std::chrono::steady_clock;
+            /* receives the number of missing bytes, returns the number of bytes it released */
+            using reclaimer = std::function<std::size_t(std::size_t)>;
+            using reclaimer_id = std::size_t;
+
+        public:
+            explicit memory_budget(std::size_t capacity) noexcept
+            : capacity_{capacity}, used_{0}, next_ticket_{0}, next_reclaimer_{1}
+            {}
+
+            memory_budget(const memory_budget&) = delete;
+            auto operator=(const memory_budget&) -> memory_budget& = delete;
+
+            /* blocks until bytes fit into the budget, throws std::bad_alloc if they never can */
+            auto acquire(std::size_t bytes) -> void
+            {
+                acquire_until(bytes, clock_type::time_point::max());
+            }
+
+            /* succeeds only if nobody is waiting and bytes fit right away */
+            auto try_acquire(std::size_t bytes) -> bool
+            {
+                auto&& lock = lock_type{mutex_};
+                if(!queue_.empty() || used_ + bytes > capacity_)
+                    return false;
+
+                used_ += bytes;
+                return true;
+            }
+
+            template <class Rep, class Period>
+            auto try_acquire_for(std::size_t bytes, const std::chrono::duration<Rep, Period>& timeout) -> bool
+            {
+                return acquire_until(bytes, clock_type::now() + std::chrono::duration_cast<clock_type::duration>(timeout));
+            }
+
+            auto release(std::size_t bytes) noexcept -> void
+            {
+                auto&& lock = lock_type{mutex_};
+                used_ -= std::min(bytes, used_);
+                if(!queue_.empty())
+                    cv_.notify_all();
+            }
+
+            auto add_reclaimer(reclaimer r) -> reclaimer_id
+            {
+                auto&& lock = lock_type{reclaim_mutex_};
+                auto id = next_reclaimer_++;
+                reclaimers_.emplace(id, std::move(r));
+                return id;
+            }
+
+            /* waits for a reclaim in progress, afterwards the reclaimer is never called again */
+            auto remove_reclaimer(reclaimer_id id) noexcept -> void
+            {
+                auto&& lock = lock_type{reclaim_mutex_};
+                reclaimers_.erase(id);
+            }
+
+            /* runs f while no reclaimer is called, e.g. to re-point the state a reclaimer refers to */
+            template <class F>
+            auto without_reclaims(F&& f) noexcept -> void
+            {
+                auto&& lock = lock_type{reclaim_mutex_};
+                f();
+            }
+
+            auto capacity() const noexcept -> std::size_t
+            {
+                return capacity_;
+            }
+
+            auto used() const -> std::size_t
+            {
+                auto&& lock = lock_type{mutex_};
+                return used_;
+            }
+
+            auto waiting() const -> std::size_t
+            {
+                auto&& lock = lock_type{mutex_};
+                return queue_.size();
+            }
+
+        private:
+            auto acquire_until(std::size_t bytes, clock_type::time_point deadline) -> bool
+            {
+                if(bytes > capacity_)
+                    throw std::bad_alloc{};
+
+                auto&& lock = lock_type{mutex_};
+                if(queue_.empty() && used_ + bytes <= capacity_)
+                {
+                    used_ += bytes;
+                    return true;
+                }
+
+                auto ticket = next_ticket_++;
+                queue_.push_back(ticket);
+
+                while(true)
+                {
+                    if(queue_.front() == ticket)
+                    {
+                        if(used_ + bytes <= capacity_)
+                        {
+                            used_ += bytes;
+                            queue_.pop_front();
+                            cv_.notify_all();
+                            return true;
+                        }
+
+                        // only the head of the queue asks the pools to give memory back
+                        auto missing = used_ + bytes - capacity_;
+                        lock.unlock();
+                        auto freed = reclaim(missing);
+                        lock.lock();
+                        if(freed != 0)
+                            continue;
+                    }
+
+                    // release() notifies; the timeout lets the head retry reclaiming
+                    auto wake = std::min(deadline, clock_type::now() + std::chrono::milliseconds{10});
+                    cv_.wait_until(lock, wake);
+
+                    if(clock_type::now() >= deadline)
+                    {
+                        queue_.erase(std::find(std::begin(queue_), std::end(queue_), ticket));
+                        cv_.notify_all();
+                        return false;
+                    }
+                }
+            }
+
+            auto reclaim(std::size_t missing) -> std::size_t
+            {
+                auto&& lock = lock_type{reclaim_mutex_};
+                auto freed = std::size_t{0};
+                for(auto&& r : reclaimers_)
+                {
+                    if(freed >= missing)
+                        break;
+                    freed += r.second(missing - freed);
+                }
+                return freed;
+            }
+
+        private:
+            std::size_t capacity_;
+            std::size_t used_;
+            std::uint64_t next_ticket_;
+            std::deque<std::uint64_t> queue_;
+            mutable std::mutex mutex_;
+            std::condition_variable cv_;
+
+            std::mutex reclaim_mutex_;
+            reclaimer_id next_reclaimer_;
+            std::map<reclaimer_id, reclaimer> reclaimers_;
+    };
+}
+
+#endif /* GLADOS_BITS_MEMORY_BUDGET_H_ */
@@ -29,7 +29,8 @@ namespace glados
     {
         pointer_1D,
         pointer_2D,
-        pointer_3D
+        pointer_3D,
+        bricked_3D  // 3D, stored brick by brick, see bricked_layout
     };
 }
 
@@ -0,0 +1,279 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_BITS_NODE_CACHE_H_
+#define GLADOS_BITS_NODE_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glados/bits/numa.h>
+#include <glados/bits/pool_cache.h>
+#include <glados/bits/pool_deleter.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Remembers the NUMA node every buffer was first touched on. The map is
+         * split into shards with their own lock so that concurrent deallocations
+         * rarely meet.
+         */
+        class home_registry
+        {
+            private:
+                struct shard
+                {
+                    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+                    std::unordered_map<const void*, std::size_t> homes;
+                    char padding[64];
+                };
+
+            public:
+                static constexpr auto shard_count = std::size_t{64};
+
+            public:
+                home_registry()
+                : shards_{new shard[shard_count]}
+                {}
+
+                auto insert(const void* p, std::size_t node) -> void
+                {
+                    auto& s = shard_of(p);
+                    lock(s);
+                    try
+                    {
+                        s.homes[p] = node;
+                    }
+                    catch(...)
+                    {
+                        unlock(s);
+                        throw;
+                    }
+                    unlock(s);
+                }
+
+                /* unknown buffers belong to node 0 */
+                auto find(const void* p) noexcept -> std::size_t
+                {
+                    auto& s = shard_of(p);
+                    lock(s);
+                    auto it = s.homes.find(p);
+                    auto node = (it == std::end(s.homes)) ? std::size_t{0} : it->second;
+                    unlock(s);
+                    return node;
+                }
+
+                auto erase(const void* p) noexcept -> void
+                {
+                    auto& s = shard_of(p);
+                    lock(s);
+                    s.homes.erase(p);
+                    unlock(s);
+                }
+
+            private:
+                auto shard_of(const void* p) noexcept -> shard&
+                {
+                    // buffers are at least page-aligned if they are large enough to matter
+                    auto a = reinterpret_cast<std::uintptr_t>(p);
+                    return shards_[((a >> 12) ^ (a >> 20) ^ (a >> 6)) % shard_count];
+                }
+
+                static auto lock(shard& s) noexcept -> void
+                {
+                    while(s.lock.test_and_set(std::memory_order_acquire))
+                        std::this_thread::yield();
+                }
+
+                static auto unlock(shard& s) noexcept -> void
+                {
+                    s.lock.clear(std::memory_order_release);
+                }
+
+            private:
+                std::unique_ptr<shard[]> shards_;
+        };
+
+        /*
+         * Idle buffer cache of a pool, optionally split by NUMA node. Without
+         * NUMA awareness it is a single pool_cache. With it, every node has a
+         * pool_cache of its own: returned buffers go back to the cache of their
+         * home node (the node of the thread that created and first touched
+         * them), allocations try the caller's node first and fall back to the
+         * other nodes before a new buffer has to be created.
+         *
+         * The interface mirrors pool_cache; adopt() and forget() keep the home
+         * registry up to date when the pool creates or frees a buffer.
+         */
+        template <class Pointer>
+        class node_cache
+        {
+            public:
+                using usage = typename pool_cache<Pointer>::usage;
+
+            public:
+                explicit node_cache(bool numa_aware = false)
+                : numa_aware_{numa_aware}
+                {
+                    auto nodes = numa_aware_ ? numa_nodes() : std::size_t{1};
+                    caches_.reserve(nodes);
+                    for(auto i = std::size_t{0}; i < nodes; ++i)
+                        caches_.emplace_back();
+
+                    if(numa_aware_)
+                        homes_.reset(new home_registry{});
+                }
+
+                node_cache(node_cache&&) noexcept = default;
+                auto operator=(node_cache&&) noexcept -> node_cache& = default;
+
+                auto numa_aware() const noexcept -> bool
+                {
+                    return numa_aware_;
+                }
+
+                /* the node new buffers are placed on and reuse starts from */
+                auto local_node() const noexcept -> std::size_t
+                {
+                    return numa_aware_ ? (current_numa_node() % caches_.size()) : 0;
+                }
+
+                auto push(const Pointer& p) noexcept -> push_result
+                {
+                    return caches_[home(p)].push(p);
+                }
+
+                auto pop(Pointer& p) noexcept -> bool
+                {
+                    auto local = local_node();
+                    for(auto i = std::size_t{0}; i < caches_.size(); ++i)
+                    {
+                        if(caches_[(local + i) % caches_.size()].pop(p))
+                            return true;
+                    }
+                    return false;
+                }
+
+                auto record_miss() noexcept -> void
+                {
+                    caches_[local_node()].record_miss();
+                }
+
+                auto counters() noexcept -> usage
+                {
+                    auto u = usage{0, 0, 0, 0};
+                    for(auto&& c : caches_)
+                    {
+                        auto cu = c.counters();
+                        u.hits += cu.hits;
+                        u.misses += cu.misses;
+                        u.returns += cu.returns;
+                        u.idle += cu.idle;
+                    }
+                    return u;
+                }
+
+                auto stock(const Pointer& p) noexcept -> bool
+                {
+                    return caches_[home(p)].stock(p);
+                }
+
+                /* registers a new buffer created by the calling thread */
+                auto adopt(const Pointer& p) -> void
+                {
+                    auto node = local_node();
+                    if(numa_aware_)
+                        homes_->insert(address_of(p), node);
+                    caches_[node].add_spare();
+                }
+
+                /* called before a buffer is returned to the internal allocator */
+                auto forget(const Pointer& p) noexcept -> void
+                {
+                    if(numa_aware_)
+                        homes_->erase(address_of(p));
+                }
+
+                auto depot_size() const noexcept -> std::size_t
+                {
+                    auto size = std::size_t{0};
+                    for(auto&& c : caches_)
+                        size += c.depot_size();
+                    return size;
+                }
+
+                template <class F>
+                auto evict(std::size_t count, F&& f) noexcept -> std::size_t
+                {
+                    auto n = std::size_t{0};
+                    for(auto&& c : caches_)
+                        n += c.evict(count - n, f);
+                    return n;
+                }
+
+                /* every node keeps its share of keep */
+                template <class F>
+                auto shrink_depot(std::size_t keep, F&& f) noexcept -> void
+                {
+                    auto share = (keep == static_cast<std::size_t>(-1)) ? keep : (keep + caches_.size() - 1) / caches_.size();
+                    for(auto&& c : caches_)
+                        c.shrink_depot(share, f);
+                }
+
+                template <class F>
+                auto age_out(F&& f) noexcept -> void
+                {
+                    for(auto&& c : caches_)
+                        c.age_out(f);
+                }
+
+                template <class F>
+                auto drain(F&& f) noexcept -> void
+                {
+                    for(auto&& c : caches_)
+                        c.drain(f);
+                }
+
+            private:
+                auto home(const Pointer& p) noexcept -> std::size_t
+                {
+                    return numa_aware_ ? (homes_->find(address_of(p)) % caches_.size()) : 0;
+                }
+
+            private:
+                bool numa_aware_;
+                std::vector<pool_cache<Pointer>> caches_;
+                std::unique_ptr<home_registry> homes_;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_NODE_CACHE_H_ */
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_BITS_NUMA_H_
+#define GLADOS_BITS_NUMA_H_
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sched.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        /* parses a sysfs list like "0-3,8,10-11" and calls f for every entry */
+        template <class F>
+        auto for_each_in_list(const std::string& list, F&& f) -> void
+        {
+            auto pos = std::size_t{0};
+            while(pos < list.size())
+            {
+                auto end = list.find(',', pos);
+                if(end == std::string::npos)
+                    end = list.size();
+
+                auto range = list.substr(pos, end - pos);
+                auto dash = range.find('-');
+                try
+                {
+                    auto first = std::stoul(range.substr(0, dash));
+                    auto last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+                    for(auto i = first; i <= last; ++i)
+                        f(static_cast<std::size_t>(i));
+                }
+                catch(...)
+                {
+                    // malformed or empty entry (e.g. the trailing newline), ignore it
+                }
+
+                pos = end + 1;
+            }
+        }
+
+        inline auto read_sysfs_list(const std::string& path) -> std::string
+        {
+            auto file = std::ifstream{path};
+            auto line = std::string{};
+            std::getline(file, line);
+            return line;
+        }
+
+        /*
+         * CPU and node layout of the machine as reported by sysfs. Without sysfs
+         * (or on a machine without NUMA) everything is mapped to node 0.
+         */
+        class numa_topology
+        {
+            public:
+                numa_topology()
+                : nodes_{1}
+                {
+                    for_each_in_list(read_sysfs_list("/sys/devices/system/node/possible"), [this](std::size_t node)
+                    {
+                        if(node + 1 > nodes_)
+                            nodes_ = node + 1;
+                    });
+
+                    for(auto node = std::size_t{0}; node < nodes_; ++node)
+                    {
+                        auto path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+                        for_each_in_list(read_sysfs_list(path), [this, node](std::size_t cpu)
+                        {
+                            if(cpu >= cpu_nodes_.size())
+                                cpu_nodes_.resize(cpu + 1, 0);
+                            cpu_nodes_[cpu] = node;
+                        });
+                    }
+                }
+
+                auto nodes() const noexcept -> std::size_t
+                {
+                    return nodes_;
+                }
+
+                auto node_of_cpu(int cpu) const noexcept -> std::size_t
+                {
+                    if(cpu < 0 || static_cast<std::size_t>(cpu) >= cpu_nodes_.size())
+                        return 0;
+                    return cpu_nodes_[static_cast<std::size_t>(cpu)];
+                }
+
+            private:
+                std::size_t nodes_;
+                std::vector<std::size_t> cpu_nodes_;
+        };
+
+        inline auto topology() -> const numa_topology&
+        {
+            static const auto t = numa_topology{};
+            return t;
+        }
+
+        inline auto numa_nodes() -> std::size_t
+        {
+            return topology().nodes();
+        }
+
+        /*
+         * the node the calling thread runs on right now; sched_getcpu() is served by the vDSO.
+         * Falls back to node 0 if the topology cannot be read (e.g. out of memory on first use).
+         */
+        inline auto current_numa_node() noexcept -> std::size_t
+        {
+            try
+            {
+                return topology().node_of_cpu(::sched_getcpu());
+            }
+            catch(...)
+            {
+                return 0;
+            }
+        }
+    }
+}
+
+#endif /* GLADOS_BITS_NUMA_H_ */
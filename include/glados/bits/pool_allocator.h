@@ -24,23 +24,520 @@
 #define GLADOS_BITS_POOL_ALLOCATOR_H_
 
 #include <atomic>
-#include <forward_list>
-#include <functional>
-#include <thread>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
 
+#include <glados/bits/first_touch.h>
+#include <glados/bits/memory_budget.h>
 #include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+#include <glados/bits/node_cache.h>
+#include <glados/bits/pool_deleter.h>
+#include <glados/bits/pool_limit.h>
+#include <glados/bits/pool_policy.h>
+#include <glados/bits/pool_shape.h>
+#include <glados/bits/pool_statistics.h>
 
 namespace glados
 {
+    namespace detail
+    {
+        /* passes a pool's extents to InternalAlloc in the form its layout expects */
+        template <memory_layout ml>
+        struct pool_layout {};
+
+        template <>
+        struct pool_layout<memory_layout::pointer_1D>
+        {
+            template <class Alloc>
+            static auto allocate(Alloc& alloc, const pool_shape& s) -> typename Alloc::pointer
+            {
+                return alloc.allocate(s.x);
+            }
+
+            template <class Alloc>
+            static auto deallocate(Alloc& alloc, typename Alloc::pointer p, const pool_shape& s) noexcept -> void
+            {
+                alloc.deallocate(p, s.x);
+            }
+        };
+
+        template <>
+        struct pool_layout<memory_layout::pointer_2D>
+        {
+            template <class Alloc>
+            static auto allocate(Alloc& alloc, const pool_shape& s) -> typename Alloc::pointer
+            {
+                return alloc.allocate(s.x, s.y);
+            }
+
+            template <class Alloc>
+            static auto deallocate(Alloc& alloc, typename Alloc::pointer p, const pool_shape& s) noexcept -> void
+            {
+                alloc.deallocate(p, s.x, s.y);
+            }
+        };
+
+        template <>
+        struct pool_layout<memory_layout::pointer_3D>
+        {
+            template <class Alloc>
+            static auto allocate(Alloc& alloc, const pool_shape& s) -> typename Alloc::pointer
+            {
+                return alloc.allocate(s.x, s.y, s.z);
+            }
+
+            template <class Alloc>
+            static auto deallocate(Alloc& alloc, typename Alloc::pointer p, const pool_shape& s) noexcept -> void
+            {
+                alloc.deallocate(p, s.x, s.y, s.z);
+            }
+        };
+
+        /*
+         * Everything the pool_allocator specializations share: the cache, the
+         * limit, the budget and the owning shutdown. The extents are kept as a
+         * pool_shape with the unused dimensions set to 1, Shape forwards them to
+         * InternalAlloc. The specializations only add the per-layout signatures.
+         */
+        template <class T, class InternalAlloc, class Shape>
+        class pool_core
+        {
+            public:
+                static constexpr auto mem_location = InternalAlloc::mem_location;
+
+                using pointer = typename InternalAlloc::pointer;
+                using size_type = typename InternalAlloc::size_type;
+
+            protected:
+                pool_core() = default;
+
+                explicit pool_core(size_type limit)
+                : alloc_{}, cache_{}, limit_{limit}
+                {}
+
+                pool_core(size_type limit, pool_policy policy)
+                : alloc_{}, cache_{policy.numa_aware}, limit_{limit}, policy_{policy}
+                {
+                    attach_budget();
+                }
+
+                pool_core(pool_core&& other) noexcept
+                : alloc_{std::move(other.alloc_)}, cache_{std::move(other.cache_)}
+                , extents_(other.extents_), limit_{std::move(other.limit_)}
+                , buffers_{other.buffers_.load()}, high_water_{other.high_water_.load()}
+                , policy_{other.policy_}, age_timer_{other.age_timer_}, moved_{other.moved_}
+                {
+                    // take over other's reclaimer instead of registering a new one, which could throw
+                    reclaimer_ = other.reclaimer_;
+                    reclaim_target_ = std::move(other.reclaim_target_);
+                    other.reclaimer_ = 0;
+                    other.moved_ = true;
+                    retarget_budget();
+                }
+
+                auto operator=(pool_core&& other) noexcept -> pool_core&
+                {
+                    detach_budget();
+                    alloc_ = std::move(other.alloc_);
+                    cache_ = std::move(other.cache_);
+                    extents_ = other.extents_;
+                    limit_ = std::move(other.limit_);
+                    buffers_ = other.buffers_.load();
+                    high_water_ = other.high_water_.load();
+                    policy_ = other.policy_;
+                    age_timer_ = other.age_timer_;
+                    moved_ = other.moved_;
+
+                    reclaimer_ = other.reclaimer_;
+                    reclaim_target_ = std::move(other.reclaim_target_);
+                    other.reclaimer_ = 0;
+                    other.moved_ = true;
+                    retarget_budget();
+
+                    return *this;
+                }
+
+                pool_core(const pool_core& other) noexcept = delete;
+                auto operator=(const pool_core& other) noexcept -> pool_core& = delete;
+
+                ~pool_core()
+                {
+                    detach_budget();
+
+                    // unless the pool is owning, pool_allocator's contents have to be released manually
+                    if(moved_ || !policy_.owning)
+                        return;
+
+                    auto bounded = policy_.close_timeout != std::chrono::steady_clock::duration::zero();
+                    auto returned = wait_for_outstanding(std::chrono::steady_clock::now() + policy_.close_timeout, bounded);
+                    assert(returned && "glados::pool_allocator: buffers were still outstanding when the owning pool was destroyed");
+                    static_cast<void>(returned);
+
+                    release();
+                }
+
+            public:
+                auto release() noexcept -> void
+                {
+                    if(moved_) // the allocator becomes invalid once moved from
+                        return;
+
+                    cache_.drain([this](pointer& p) { discard(p); });
+
+                    extents_ = pool_shape{0, 0, 0};
+                    limit_.reset();
+                }
+
+                /* returns the idle buffers exceeding the pool_policy to InternalAlloc */
+                auto trim() noexcept -> void
+                {
+                    if(moved_ || trimming_.test_and_set(std::memory_order_acquire))
+                        return;
+
+                    auto idle = cache_.counters().idle;
+                    auto allowed = detail::idle_allowance(policy_, buffer_bytes());
+                    if(idle > allowed)
+                        cache_.evict(idle - allowed, [this](pointer& p) { discard(p); });
+
+                    if(age_timer_.due(policy_))
+                        cache_.age_out([this](pointer& p) { discard(p); });
+
+                    trimming_.clear(std::memory_order_release);
+                }
+
+                /*
+                 * Waits until every buffer handed out has been returned, but at most
+                 * for timeout. Returns false if buffers are still outstanding, which
+                 * lets the owner find leaked buffers before an owning pool's
+                 * destructor waits for them.
+                 */
+                template <class Rep, class Period>
+                auto wait_for_returns(const std::chrono::duration<Rep, Period>& timeout) -> bool
+                {
+                    if(moved_)
+                        return true;
+
+                    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+                    return wait_for_outstanding(deadline, true);
+                }
+
+                auto statistics() -> pool_statistics
+                {
+                    if(moved_)
+                        return pool_statistics{};
+
+                    auto u = cache_.counters();
+                    auto w = limit_.waited();
+
+                    // the slots are summed one after another, so the counters may be slightly inconsistent
+                    auto handed_out = u.hits + u.misses;
+                    auto outstanding = (handed_out > u.returns) ? handed_out - u.returns : 0;
+
+                    return pool_statistics{u.hits, u.misses, outstanding, high_water_.load(),
+                                           u.idle, u.idle * buffer_bytes(),
+                                           w.waits, std::chrono::duration_cast<std::chrono::nanoseconds>(w.total),
+                                           std::chrono::duration_cast<std::chrono::nanoseconds>(w.max)};
+                }
+
+            protected:
+                auto allocate_shape(const pool_shape& s) -> pointer
+                {
+                    if(moved_)
+                        return pointer{nullptr};
+
+                    latch(s);
+                    limit_.acquire();
+                    return take();
+                }
+
+                /* returns nullptr instead of waiting if the limit has been reached */
+                auto try_allocate_shape(const pool_shape& s) -> pointer
+                {
+                    if(moved_)
+                        return pointer{nullptr};
+
+                    latch(s);
+                    if(!limit_.try_acquire())
+                        return pointer{nullptr};
+                    return take();
+                }
+
+                /* returns nullptr if no buffer became available within timeout */
+                template <class Rep, class Period>
+                auto allocate_shape_for(const pool_shape& s, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+                {
+                    if(moved_)
+                        return pointer{nullptr};
+
+                    latch(s);
+                    if(!limit_.try_acquire_for(timeout))
+                        return pointer{nullptr};
+                    return take();
+                }
+
+                auto return_buffer(pointer p) noexcept -> void
+                {
+                    if(moved_ || (p == nullptr))
+                        return;
+
+                    // an owning pool's destructor has to wait for deallocate() calls in progress
+                    if(policy_.owning)
+                        ++returning_;
+
+                    auto result = cache_.push(p);
+                    if(result == detail::push_result::rejected) // magazine full and no memory for depot nodes
+                        discard(p);
+                    limit_.release();
+
+                    if(result == detail::push_result::spilled && detail::trims(policy_))
+                        trim_depot();
+
+                    if(policy_.owning)
+                        leave_deallocate();
+                }
+
+                /*
+                 * Creates idle buffers until at least count are available, so the first
+                 * allocations do not pay for InternalAlloc::allocate(). With touch set,
+                 * host memory is faulted in right away, on the calling thread.
+                 */
+                auto reserve_shape(size_type count, const pool_shape& s, bool touch) -> void
+                {
+                    if(moved_)
+                        return;
+
+                    latch(s);
+                    for(auto idle = cache_.counters().idle; idle < count; ++idle)
+                    {
+                        auto p = create();
+                        if(touch)
+                            detail::first_touch<InternalAlloc>(p, buffer_bytes(), std::integral_constant<bool, mem_location == memory_location::host>{});
+
+                        if(!cache_.stock(p))
+                        {
+                            discard(p);
+                            return;
+                        }
+                    }
+                }
+
+            private:
+                auto latch(const pool_shape& s) noexcept -> void
+                {
+                    if(extents_.x == 0)
+                        extents_.x = s.x;
+                    if(extents_.y == 0)
+                        extents_.y = s.y;
+                    if(extents_.z == 0)
+                        extents_.z = s.z;
+                }
+
+                /* hands out an idle buffer or creates a new one, the caller already holds a slot of limit_ */
+                auto take() -> pointer
+                {
+                    auto ret = static_cast<pointer>(nullptr);
+                    if(cache_.pop(ret))
+                        return ret;
+
+                    try
+                    {
+                        ret = create();
+                    }
+                    catch(...)
+                    {
+                        limit_.release();
+                        throw;
+                    }
+
+                    cache_.record_miss();
+                    return ret;
+                }
+
+                auto discard(pointer& p) noexcept -> void
+                {
+                    cache_.forget(p);
+                    Shape::deallocate(alloc_, p, extents_);
+                    --buffers_;
+                    give_back_budget();
+                }
+
+                auto buffer_bytes() const noexcept -> std::size_t
+                {
+                    return extents_.x * extents_.y * extents_.z * sizeof(T);
+                }
+
+                auto give_back_budget() noexcept -> void
+                {
+                    if(policy_.budget != nullptr)
+                        policy_.budget->release(buffer_bytes());
+                }
+
+                /* lets the budget take idle buffers away when another participant runs short */
+                auto attach_budget() -> void
+                {
+                    if(moved_ || policy_.budget == nullptr)
+                        return;
+
+                    // the reclaimer reaches the pool through reclaim_target_, which follows it on moves
+                    reclaim_target_.reset(new reclaim_target{this});
+                    auto target = reclaim_target_.get();
+                    reclaimer_ = policy_.budget->add_reclaimer([target](std::size_t missing)
+                    {
+                        auto pool = target->pool;
+                        auto bytes = pool->buffer_bytes();
+                        if(bytes == 0)
+                            return std::size_t{0};
+                        return pool->cache_.evict((missing + bytes - 1) / bytes, [pool](pointer& p) { pool->discard(p); }) * bytes;
+                    });
+                }
+
+                auto retarget_budget() noexcept -> void
+                {
+                    if(reclaim_target_ == nullptr)
+                        return;
+
+                    auto target = reclaim_target_.get();
+                    policy_.budget->without_reclaims([this, target]() { target->pool = this; });
+                }
+
+                auto detach_budget() noexcept -> void
+                {
+                    if(reclaimer_ == 0)
+                        return;
+
+                    policy_.budget->remove_reclaimer(reclaimer_);
+                    reclaimer_ = 0;
+                    reclaim_target_.reset();
+                }
+
+                /* cheap variant of trim() for deallocate(): only the depot is limited */
+                auto trim_depot() noexcept -> void
+                {
+                    if(trimming_.test_and_set(std::memory_order_acquire))
+                        return;
+
+                    cache_.shrink_depot(detail::idle_allowance(policy_, buffer_bytes()), [this](pointer& p) { discard(p); });
+                    if(age_timer_.due(policy_))
+                        cache_.age_out([this](pointer& p) { discard(p); });
+
+                    trimming_.clear(std::memory_order_release);
+                }
+
+                /* nothing may touch the pool after returning_ has been decremented */
+                auto leave_deallocate() noexcept -> void
+                {
+                    if(!closing_.load())
+                    {
+                        --returning_;
+                        return;
+                    }
+
+                    auto&& lock = std::lock_guard<std::mutex>{closing_mutex_};
+                    --returning_;
+                    closing_cv_.notify_all();
+                }
+
+                /* returns false if bounded and buffers are still outstanding at deadline */
+                auto wait_for_outstanding(std::chrono::steady_clock::time_point deadline, bool bounded) -> bool
+                {
+                    closing_ = true;
+
+                    auto&& lock = std::unique_lock<std::mutex>{closing_mutex_};
+                    while(true)
+                    {
+                        auto u = cache_.counters();
+                        if(u.hits + u.misses <= u.returns && returning_.load() == 0)
+                            return true;
+
+                        if(bounded && std::chrono::steady_clock::now() >= deadline)
+                            return false;
+
+                        // the timeout covers a deallocate() which missed closing_
+                        closing_cv_.wait_for(lock, std::chrono::milliseconds{10});
+                    }
+                }
+
+                auto create() -> pointer
+                {
+                    if(policy_.budget != nullptr)
+                        policy_.budget->acquire(buffer_bytes());
+
+                    auto ret = static_cast<pointer>(nullptr);
+                    try
+                    {
+                        ret = Shape::allocate(alloc_, extents_);
+                    }
+                    catch(...)
+                    {
+                        give_back_budget();
+                        throw;
+                    }
+
+                    try
+                    {
+                        cache_.adopt(ret); // keeps deallocate() free of allocations
+                    }
+                    catch(...)
+                    {
+                        Shape::deallocate(alloc_, ret, extents_);
+                        give_back_budget();
+                        throw;
+                    }
+
+                    // in NUMA-aware mode the pages have to end up on the node adopt() registered
+                    if(cache_.numa_aware())
+                        detail::first_touch<InternalAlloc>(ret, buffer_bytes(), std::integral_constant<bool, mem_location == memory_location::host>{});
+
+                    auto owned = ++buffers_;
+                    auto peak = high_water_.load();
+                    while(owned > peak && !high_water_.compare_exchange_weak(peak, owned)) {}
+
+                    return ret;
+                }
+
+            private:
+                /* what the budget's reclaimer operates on */
+                struct reclaim_target
+                {
+                    pool_core* pool;
+                };
+
+                InternalAlloc alloc_;
+                detail::node_cache<pointer> cache_;
+                pool_shape extents_ = pool_shape{0, 0, 0};
+                detail::pool_limit limit_;
+                std::atomic<size_type> buffers_{0};
+                std::atomic<size_type> high_water_{0};
+                pool_policy policy_;
+                detail::idle_age_timer age_timer_;
+                std::atomic_flag trimming_ = ATOMIC_FLAG_INIT;
+                std::atomic<bool> closing_{false};
+                std::atomic<size_type> returning_{0};
+                std::mutex closing_mutex_;
+                std::condition_variable closing_cv_;
+                memory_budget::reclaimer_id reclaimer_ = 0;
+                std::unique_ptr<reclaim_target> reclaim_target_;
+                bool moved_ = false;
+        };
+    }
+
     template <class T, memory_layout ml, class InternalAlloc, class = typename std::enable_if<(ml == InternalAlloc::mem_layout)>::type>
     class pool_allocator {};
 
     /* 1D specialization */
     template <class T, class InternalAlloc>
     class pool_allocator<T, memory_layout::pointer_1D, InternalAlloc>
+    : public detail::pool_core<T, InternalAlloc, detail::pool_layout<memory_layout::pointer_1D>>
     {
+        private:
+            using core_type = detail::pool_core<T, InternalAlloc, detail::pool_layout<memory_layout::pointer_1D>>;
+
         public:
             static constexpr auto mem_layout = InternalAlloc::mem_layout;
             static constexpr auto mem_location = InternalAlloc::mem_location;
@@ -55,7 +552,8 @@ namespace glados
             using propagate_on_container_move_assignment = std::true_type;
             using propagate_on_container_swap = std::true_type;
             using is_always_equal = std::true_type;
-            using smart_pointer = typename InternalAlloc::template smart_pointer<std::function<void(T*)>>;
+            using deleter_type = pool_deleter<T, pool_allocator>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
 
             template <class U>
             struct rebind
@@ -67,130 +565,63 @@ namespace glados
             pool_allocator() = default;
 
             pool_allocator(size_type limit) noexcept
-            : alloc_{}, list_{}, n_{}, limit_{limit}, current_{0}
+            : core_type{limit}
             {}
 
-            pool_allocator(pool_allocator&& other) noexcept
-            : alloc_{std::move(other.alloc_)}, list_{std::move(other.list_)}
-            , n_{other.n_}, limit_{other.limit_}, current_{other.current_.load()}, moved_{other.moved_}
-            {
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
-                other.moved_ = true;
-            }
-
-            auto operator=(pool_allocator&& other) noexcept -> pool_allocator&
-            {
-                alloc_ = std::move(other.alloc_);
-                list_ = std::move(other.list_);
-                n_ = other.n_;
-                limit_ = other.limit_;
-                current_ = other.current_.load();
-                moved_ = other.moved_;
-
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
-                other.moved_ = true;
+            pool_allocator(size_type limit, pool_policy policy)
+            : core_type{limit, policy}
+            {}
 
-                return *this;
-            }
+            pool_allocator(pool_allocator&& other) noexcept = default;
+            auto operator=(pool_allocator&& other) noexcept -> pool_allocator& = default;
 
             pool_allocator(const pool_allocator& other) noexcept = delete;
             auto operator=(const pool_allocator& other) noexcept -> pool_allocator& = delete;
 
-            ~pool_allocator()
+            auto allocate(size_type n) -> pointer
             {
-                // pool_allocator's contents have to be released manually
+                return this->allocate_shape(pool_shape{n, 1, 1});
             }
 
-            auto allocate(size_type n) -> pointer
+            /* returns nullptr instead of waiting if the limit has been reached */
+            auto try_allocate(size_type n) -> pointer
             {
-                if(moved_)
-                    return pointer{nullptr};
-
-                if(n_ == 0)
-                    n_ = n;
-
-                auto ret = static_cast<pointer>(nullptr);
-
-                if(limit_ != 0)
-                {
-                    while(current_.load() >= limit_)
-                        std::this_thread::yield();
-                }
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                if(list_.empty())
-                    ret = alloc_.allocate(n_);
-                else
-                {
-                    ret = std::move(list_.front());
-                    list_.pop_front();
-                }
-
-                ++current_;
-                lock_.clear(std::memory_order_release);
+                return this->try_allocate_shape(pool_shape{n, 1, 1});
+            }
 
-                return ret;
+            /* returns nullptr if no buffer became available within timeout */
+            template <class Rep, class Period>
+            auto allocate_for(size_type n, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+            {
+                return this->allocate_shape_for(pool_shape{n, 1, 1}, timeout);
             }
 
             auto allocate_smart(size_type n) -> smart_pointer
             {
-                return smart_pointer{allocate(n), [this](T* ptr){ this->deallocate(ptr); }};
+                auto p = allocate(n);
+                return smart_pointer{p, deleter_type{this, detail::pitch_of(p, n * sizeof(T)), pool_shape{n, 1, 1}}};
             }
 
             auto deallocate(pointer p, size_type = 0) noexcept -> void
             {
-                if(moved_ || (p == nullptr))
-                    return;
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                list_.push_front(p);
-                --current_;
-                lock_.clear(std::memory_order_release);
+                this->return_buffer(p);
             }
 
-            auto release() noexcept -> void
+            /* see pool_core::reserve_shape() */
+            auto reserve(size_type count, size_type n, bool touch = false) -> void
             {
-                if(moved_)
-                    return;
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                for(auto&& p : list_)
-                    alloc_.deallocate(p, n_);
-
-                n_ = 0;
-                current_.store(0);
-
-                lock_.clear(std::memory_order_release);
+                this->reserve_shape(count, pool_shape{n, 1, 1}, touch);
             }
-
-        private:
-            InternalAlloc alloc_;
-            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
-            std::forward_list<pointer> list_;
-            size_type n_;
-            size_type limit_;
-            std::atomic_size_t current_;
-            bool moved_ = false;
     };
 
     /* 2D specialization */
     template <class T, class InternalAlloc>
     class pool_allocator<T, memory_layout::pointer_2D, InternalAlloc>
+    : public detail::pool_core<T, InternalAlloc, detail::pool_layout<memory_layout::pointer_2D>>
     {
+        private:
+            using core_type = detail::pool_core<T, InternalAlloc, detail::pool_layout<memory_layout::pointer_2D>>;
+
         public:
             static constexpr auto mem_layout = InternalAlloc::mem_layout;
             static constexpr auto mem_location = InternalAlloc::mem_location;
@@ -205,7 +636,8 @@ namespace glados
             using propagate_on_container_move_assignment = std::true_type;
             using propagate_on_container_swap = std::true_type;
             using is_always_equal = std::true_type;
-            using smart_pointer = typename InternalAlloc::template smart_pointer<std::function<void(T*)>>;
+            using deleter_type = pool_deleter<T, pool_allocator>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
 
             template <class U>
             struct rebind
@@ -217,151 +649,79 @@ namespace glados
             pool_allocator() = default;
 
             pool_allocator(size_type limit)
-            : alloc_{}, list_{}, x_{0}, y_{0}, limit_{limit}, current_{0}
+            : core_type{limit}
             {}
 
-            pool_allocator(pool_allocator&& other) noexcept
-            : alloc_{std::move(other.alloc_)}, list_{std::move(other.list_)}
-            , x_{other.x_}, y_{other.y_}, limit_{other.limit_}, current_{other.current_.load()}, moved_{other.moved_}
-            {
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
-                other.moved_ = true;
-            }
+            pool_allocator(size_type limit, pool_policy policy)
+            : core_type{limit, policy}
+            {}
 
-            auto operator=(pool_allocator&& other) noexcept -> pool_allocator&
-            {
-                alloc_ = std::move(other.alloc_);
-                list_ = std::move(other.list_);
-                x_ = other.x_;
-                y_ = other.y_;
-                limit_ = other.limit_;
-                current_ = other.current_.load();
-                moved_ = other.moved_;
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
-                other.moved_ = true;
-
-                return *this;
-            }
+            pool_allocator(pool_allocator&& other) noexcept = default;
+            auto operator=(pool_allocator&& other) noexcept -> pool_allocator& = default;
 
             pool_allocator(const pool_allocator& other) noexcept = delete;
             auto operator=(const pool_allocator& other) noexcept -> pool_allocator& = delete;
 
-            ~pool_allocator()
+            auto allocate(size_type x, size_type y) -> pointer
             {
-                // pool_allocator's contents have to be released manually
+                return this->allocate_shape(pool_shape{x, y, 1});
             }
 
-            auto allocate(size_type x, size_type y) -> pointer
+            /* returns nullptr instead of waiting if the limit has been reached */
+            auto try_allocate(size_type x, size_type y) -> pointer
             {
-                if(moved_)
-                    return pointer{nullptr};
-
-                if(x_ == 0)
-                    x_ = x;
-
-                if(y_ == 0)
-                    y_ = y;
-
-                auto ret = static_cast<pointer>(nullptr);
-
-                if(limit_ != 0)
-                {
-                    while(current_.load() >= limit_)
-                        std::this_thread::yield();
-                }
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                if(list_.empty())
-                    ret = alloc_.allocate(x_, y_);
-                else
-                {
-                    ret = std::move(list_.front());
-                    list_.pop_front();
-                }
-
-                ++current_;
-                lock_.clear(std::memory_order_release);
+                return this->try_allocate_shape(pool_shape{x, y, 1});
+            }
 
-                return ret;
+            /* returns nullptr if no buffer became available within timeout */
+            template <class Rep, class Period>
+            auto allocate_for(size_type x, size_type y, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+            {
+                return this->allocate_shape_for(pool_shape{x, y, 1}, timeout);
             }
 
             auto allocate_smart(size_type x, size_type y) -> smart_pointer
             {
                 auto p = allocate(x, y);
-                return smart_pointer{p, [this, p](T*){ this->deallocate(p); }};
+                return smart_pointer{p, deleter_type{this, detail::pitch_of(p, x * sizeof(T)), pool_shape{x, y, 1}}};
             }
 
             auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
             {
-                if(moved_ || (p == nullptr))
-                    return;
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                list_.push_front(p);
-                --current_;
-                lock_.clear(std::memory_order_release);
+                this->return_buffer(p);
             }
 
-            auto release() noexcept -> void
+            /* see pool_core::reserve_shape() */
+            auto reserve(size_type count, size_type x, size_type y, bool touch = false) -> void
             {
-                if(moved_) // the allocator becomes invalid once moved from
-                    return;
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                for(auto&& p : list_)
-                    alloc_.deallocate(p, x_, y_);
-
-                x_ = 0;
-                y_ = 0;
-                current_.store(0);
-
-                lock_.clear(std::memory_order_release);
+                this->reserve_shape(count, pool_shape{x, y, 1}, touch);
             }
-
-        private:
-            InternalAlloc alloc_;
-            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
-            std::forward_list<pointer> list_;
-            size_type x_;
-            size_type y_;
-            size_type limit_;
-            std::atomic_size_t current_;
-            bool moved_ = false;
     };
 
     /* 3D specialization */
     template <class T, class InternalAlloc>
     class pool_allocator<T, memory_layout::pointer_3D, InternalAlloc>
+    : public detail::pool_core<T, InternalAlloc, detail::pool_layout<memory_layout::pointer_3D>>
     {
+        private:
+            using core_type = detail::pool_core<T, InternalAlloc, detail::pool_layout<memory_layout::pointer_3D>>;
+
         public:
             static constexpr auto mem_layout = InternalAlloc::mem_layout;
             static constexpr auto mem_location = InternalAlloc::mem_location;
             static constexpr auto alloc_needs_pitch = InternalAlloc::alloc_needs_pitch;
-            using propagate_on_container_copy_assignment = std::true_type;
-            using propagate_on_container_move_assignment = std::true_type;
-            using propagate_on_container_swap = std::true_type;
-            using is_always_equal = std::true_type;
 
             using value_type = T;
             using pointer = typename InternalAlloc::pointer;
             using const_pointer = typename InternalAlloc::const_pointer;
             using size_type = typename InternalAlloc::size_type;
             using difference_type = typename InternalAlloc::difference_type;
-            using smart_pointer = typename InternalAlloc::template smart_pointer<std::function<void(T*)>>;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+            using is_always_equal = std::true_type;
+            using deleter_type = pool_deleter<T, pool_allocator>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
 
             template <class U>
             struct rebind
@@ -373,134 +733,53 @@ namespace glados
             pool_allocator() = default;
 
             pool_allocator(size_type limit)
-            : alloc_{}, list_{}, x_{}, y_{}, z_{}, limit_{limit}, current_{0}
+            : core_type{limit}
             {}
 
-            pool_allocator(pool_allocator&& other) noexcept
-            : alloc_{std::move(other.alloc_)}, list_{std::move(other.list_)}
-            , x_{other.x_}, y_{other.y_}, z_{other.z_}, limit_{other.limit_}, current_{other.current_.load()}, moved_{other.moved_}
-            {
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
+            pool_allocator(size_type limit, pool_policy policy)
+            : core_type{limit, policy}
+            {}
 
-                other.moved_ = true;
-            }
-
-            auto operator=(pool_allocator&& other) noexcept -> pool_allocator&
-            {
-                alloc_ = std::move(other.alloc_);
-                list_ = std::move(other.list_);
-                x_ = other.x_;
-                y_ = other.y_;
-                z_ = other.z_;
-                limit_ = other.limit_;
-                current_ = other.current_.load();
-                moved_ = other.moved_;
-                if(other.lock_.test_and_set())
-                    lock_.test_and_set();
-                else
-                    lock_.clear();
-
-                other.moved_ = true;
-
-                return *this;
-            }
+            pool_allocator(pool_allocator&& other) noexcept = default;
+            auto operator=(pool_allocator&& other) noexcept -> pool_allocator& = default;
 
             pool_allocator(const pool_allocator& other) noexcept = delete;
             auto operator=(const pool_allocator& other) noexcept -> pool_allocator& = delete;
 
-            ~pool_allocator()
+            auto allocate(size_type x, size_type y, size_type z) -> pointer
             {
-                // pool_allocator's contents have to be released manually
+                return this->allocate_shape(pool_shape{x, y, z});
             }
 
-            auto allocate(size_type x, size_type y, size_type z) -> pointer
+            /* returns nullptr instead of waiting if the limit has been reached */
+            auto try_allocate(size_type x, size_type y, size_type z) -> pointer
             {
-                if(moved_)
-                    return pointer{nullptr};
-
-                if(x_ == 0)
-                    x_ = x;
-                if(y_ == 0)
-                    y_ = y;
-                if(z_ == 0)
-                    z_ = z;
-
-                if(limit_ != 0)
-                {
-                    while(current_.load() >= limit_)
-                        std::this_thread::yield();
-                }
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                auto ret = static_cast<pointer>(nullptr);
-
-                if(list_.empty())
-                    ret = alloc_.allocate(x_, y_, z_);
-                else
-                {
-                    ret = std::move(list_.front());
-                    list_.pop_front();
-                }
-
-                ++current_;
-                lock_.clear(std::memory_order_release);
+                return this->try_allocate_shape(pool_shape{x, y, z});
+            }
 
-                return ret;
+            /* returns nullptr if no buffer became available within timeout */
+            template <class Rep, class Period>
+            auto allocate_for(size_type x, size_type y, size_type z, const std::chrono::duration<Rep, Period>& timeout) -> pointer
+            {
+                return this->allocate_shape_for(pool_shape{x, y, z}, timeout);
             }
 
             auto allocate_smart(size_type x, size_type y, size_type z) -> smart_pointer
             {
                 auto p = allocate(x, y, z);
-                return smart_pointer{p, [this, p](T*){ this->deallocate(p); }};
+                return smart_pointer{p, deleter_type{this, detail::pitch_of(p, x * sizeof(T)), pool_shape{x, y, z}}};
             }
 
             auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
             {
-                if(moved_ || (p == nullptr))
-                    return;
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                list_.push_front(p);
-                --current_;
-                lock_.clear(std::memory_order_release);
+                this->return_buffer(p);
             }
 
-            auto release() noexcept -> void
+            /* see pool_core::reserve_shape() */
+            auto reserve(size_type count, size_type x, size_type y, size_type z, bool touch = false) -> void
             {
-                if(moved_) // the allocator becomes invalid once moved from
-                    return;
-
-                while(lock_.test_and_set(std::memory_order_acquire))
-                    std::this_thread::yield();
-
-                for(auto&& p : list_)
-                    alloc_.deallocate(p, x_, y_, z_);
-
-                x_ = 0;
-                y_ = 0;
-                z_ = 0;
-                current_.store(0);
-
-                lock_.clear(std::memory_order_release);
+                this->reserve_shape(count, pool_shape{x, y, z}, touch);
             }
-
-        private:
-            InternalAlloc alloc_;
-            std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
-            std::forward_list<pointer> list_;
-            size_type x_;
-            size_type y_;
-            size_type z_;
-            size_type limit_;
-            std::atomic_size_t current_;
-            bool moved_ = false;
     };
 }
 
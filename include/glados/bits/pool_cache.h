@@ -0,0 +1,354 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_CACHE_H_
+#define GLADOS_BITS_POOL_CACHE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <glados/bits/free_list.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        /* dense per-thread number, used to spread threads over the magazine slots */
+        inline auto thread_slot_id() noexcept -> std::size_t
+        {
+            static std::atomic<std::size_t> next{0};
+            thread_local auto id = next++;
+            return id;
+        }
+
+        enum class push_result
+        {
+            cached,     // kept in the caller's magazine
+            spilled,    // kept, but the magazine overflowed into the depot
+            rejected    // neither magazine nor depot could take the buffer
+        };
+
+        /*
+         * Idle buffer cache of a pool: every thread works on its own magazine, a
+         * small LIFO of at most magazine_size buffers, so most allocate/deallocate
+         * pairs do not touch memory shared with other threads. A full magazine
+         * moves half of its buffers to the central depot (a free_list), an
+         * empty one refills half from the depot; only if the depot is empty, too,
+         * other magazines are searched before the caller has to create a new
+         * buffer.
+         *
+         * Threads are mapped to slots by their thread_slot_id(); threads sharing
+         * a slot contend on its flag only. Usage counters are kept per slot for
+         * the same reason and are only summed up by counters().
+         *
+         * For trimming, the cache remembers the lowest depot size since the last
+         * age_out(): that many buffers have not been used in the meantime.
+         */
+        template <class Pointer>
+        class pool_cache
+        {
+            private:
+                /* padded instead of over-aligned, C++14 new[] ignores extended alignment */
+                struct slot
+                {
+                    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+                    std::vector<Pointer> buffers;
+                    std::size_t hits = 0;
+                    std::size_t misses = 0;
+                    std::size_t returns = 0;
+                    char padding[64];
+                };
+
+            public:
+                struct usage
+                {
+                    std::size_t hits;
+                    std::size_t misses;
+                    std::size_t returns;
+                    std::size_t idle;
+                };
+
+                static constexpr auto magazine_size = std::size_t{16};
+
+            public:
+                pool_cache()
+                : slot_count_{std::max(std::size_t{4}, std::size_t{2} * std::thread::hardware_concurrency())}
+                , slots_{new slot[slot_count_]}
+                {
+                    for(auto i = std::size_t{0}; i < slot_count_; ++i)
+                        slots_[i].buffers.reserve(magazine_size);
+                }
+
+                /* not thread-safe, like the move operations of the owning pool */
+                pool_cache(pool_cache&& other) noexcept
+                : slot_count_{other.slot_count_}, slots_{std::move(other.slots_)}
+                , depot_{std::move(other.depot_)}, depot_low_{other.depot_low_.load()}
+                {}
+
+                auto operator=(pool_cache&& other) noexcept -> pool_cache&
+                {
+                    slot_count_ = other.slot_count_;
+                    slots_ = std::move(other.slots_);
+                    depot_ = std::move(other.depot_);
+                    depot_low_ = other.depot_low_.load();
+                    return *this;
+                }
+
+                /* the caller has to free p if it was rejected */
+                auto push(const Pointer& p) noexcept -> push_result
+                {
+                    auto result = push_result::cached;
+
+                    auto& s = own_slot();
+                    lock(s);
+                    ++s.returns;
+
+                    if(s.buffers.size() == magazine_size)
+                    {
+                        // overflow: hand the older half to the depot
+                        auto keep = magazine_size / 2;
+                        auto moved = std::size_t{0};
+                        while(moved < magazine_size - keep && depot_.push(s.buffers[moved]))
+                            ++moved;
+                        s.buffers.erase(std::begin(s.buffers), std::begin(s.buffers) + static_cast<std::ptrdiff_t>(moved));
+
+                        if(s.buffers.size() == magazine_size)
+                        {
+                            unlock(s);
+                            return push_result::rejected;
+                        }
+                        result = push_result::spilled;
+                    }
+
+                    s.buffers.push_back(p);
+                    unlock(s);
+                    return result;
+                }
+
+                auto pop(Pointer& p) noexcept -> bool
+                {
+                    auto& s = own_slot();
+                    lock(s);
+
+                    if(s.buffers.empty())
+                    {
+                        // underflow: refill half a magazine from the depot
+                        auto q = Pointer{nullptr};
+                        while(s.buffers.size() < magazine_size / 2 && depot_.pop(q))
+                            s.buffers.push_back(q);
+                        lower_depot_mark();
+                    }
+
+                    if(!s.buffers.empty())
+                    {
+                        p = s.buffers.back();
+                        s.buffers.pop_back();
+                        ++s.hits;
+                        unlock(s);
+                        return true;
+                    }
+
+                    unlock(s);
+                    if(!steal(p))
+                        return false;
+
+                    lock(s);
+                    ++s.hits;
+                    unlock(s);
+                    return true;
+                }
+
+                /* counts an allocation which had to create a new buffer */
+                auto record_miss() noexcept -> void
+                {
+                    auto& s = own_slot();
+                    lock(s);
+                    ++s.misses;
+                    unlock(s);
+                }
+
+                auto counters() noexcept -> usage
+                {
+                    auto u = usage{0, 0, 0, depot_.size()};
+                    for(auto i = std::size_t{0}; i < slot_count_; ++i)
+                    {
+                        auto& s = slots_[i];
+                        lock(s);
+                        u.hits += s.hits;
+                        u.misses += s.misses;
+                        u.returns += s.returns;
+                        u.idle += s.buffers.size();
+                        unlock(s);
+                    }
+                    return u;
+                }
+
+                /* adds a new buffer to the depot without counting it as returned */
+                auto stock(const Pointer& p) noexcept -> bool
+                {
+                    return depot_.push(p);
+                }
+
+                /* makes sure the depot can take one more buffer without allocating */
+                auto add_spare() noexcept -> void
+                {
+                    depot_.add_spare();
+                }
+
+                auto depot_size() const noexcept -> std::size_t
+                {
+                    return depot_.size();
+                }
+
+                /* removes up to count idle buffers, depot first, and hands them to f */
+                template <class F>
+                auto evict(std::size_t count, F&& f) noexcept -> std::size_t
+                {
+                    auto n = std::size_t{0};
+                    auto p = Pointer{nullptr};
+                    while(n < count && depot_.pop(p))
+                    {
+                        f(p);
+                        ++n;
+                    }
+
+                    for(auto i = std::size_t{0}; i < slot_count_ && n < count; ++i)
+                    {
+                        auto& s = slots_[i];
+                        lock(s);
+                        while(n < count && !s.buffers.empty())
+                        {
+                            f(s.buffers.back());
+                            s.buffers.pop_back();
+                            ++n;
+                        }
+                        unlock(s);
+                    }
+
+                    lower_depot_mark();
+                    return n;
+                }
+
+                /* removes depot buffers until at most keep are left */
+                template <class F>
+                auto shrink_depot(std::size_t keep, F&& f) noexcept -> void
+                {
+                    auto p = Pointer{nullptr};
+                    while(depot_.size() > keep && depot_.pop(p))
+                        f(p);
+                    lower_depot_mark();
+                }
+
+                /* removes the depot buffers which were not used since the last call */
+                template <class F>
+                auto age_out(F&& f) noexcept -> void
+                {
+                    auto stale = std::min(depot_low_.load(), depot_.size());
+                    auto p = Pointer{nullptr};
+                    for(auto i = std::size_t{0}; i < stale && depot_.pop(p); ++i)
+                        f(p);
+                    depot_low_.store(depot_.size());
+                }
+
+                /* removes every cached buffer and hands it to f */
+                template <class F>
+                auto drain(F&& f) noexcept -> void
+                {
+                    for(auto i = std::size_t{0}; i < slot_count_; ++i)
+                    {
+                        auto& s = slots_[i];
+                        lock(s);
+                        for(auto&& p : s.buffers)
+                            f(p);
+                        s.buffers.clear();
+                        unlock(s);
+                    }
+                    depot_.drain(f);
+                    depot_low_.store(0);
+                }
+
+            private:
+                auto own_slot() noexcept -> slot&
+                {
+                    return slots_[thread_slot_id() % slot_count_];
+                }
+
+                static auto lock(slot& s) noexcept -> void
+                {
+                    while(s.lock.test_and_set(std::memory_order_acquire))
+                        std::this_thread::yield();
+                }
+
+                static auto try_lock(slot& s) noexcept -> bool
+                {
+                    return !s.lock.test_and_set(std::memory_order_acquire);
+                }
+
+                static auto unlock(slot& s) noexcept -> void
+                {
+                    s.lock.clear(std::memory_order_release);
+                }
+
+                auto lower_depot_mark() noexcept -> void
+                {
+                    auto size = depot_.size();
+                    auto low = depot_low_.load();
+                    while(size < low && !depot_low_.compare_exchange_weak(low, size)) {}
+                }
+
+                /* slow path: takes a buffer from another thread's magazine */
+                auto steal(Pointer& p) noexcept -> bool
+                {
+                    auto own = thread_slot_id() % slot_count_;
+                    for(auto i = std::size_t{1}; i < slot_count_; ++i)
+                    {
+                        auto& s = slots_[(own + i) % slot_count_];
+                        if(!try_lock(s))
+                            continue;
+
+                        if(!s.buffers.empty())
+                        {
+                            p = s.buffers.back();
+                            s.buffers.pop_back();
+                            unlock(s);
+                            return true;
+                        }
+                        unlock(s);
+                    }
+                    return false;
+                }
+
+            private:
+                std::size_t slot_count_;
+                std::unique_ptr<slot[]> slots_;
+                free_list<Pointer> depot_;
+                std::atomic<std::size_t> depot_low_{0};
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_CACHE_H_ */
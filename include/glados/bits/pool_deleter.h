@@ -0,0 +1,111 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_DELETER_H_
+#define GLADOS_BITS_POOL_DELETER_H_
+
+#include <cstddef>
+#include <type_traits>
+
+#include <glados/bits/pool_shape.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        template <class Pointer, class T>
+        auto make_pool_pointer(T* p, std::size_t, std::true_type) noexcept -> Pointer
+        {
+            return p;
+        }
+
+        /* pitched pointers */
+        template <class Pointer, class T>
+        auto make_pool_pointer(T* p, std::size_t pitch, std::false_type) noexcept -> Pointer
+        {
+            return Pointer{p, pitch};
+        }
+
+        template <class T>
+        auto pitch_of(T*, std::size_t dense_pitch) noexcept -> std::size_t
+        {
+            return dense_pitch;
+        }
+
+        template <class Pointer>
+        auto pitch_of(const Pointer& p, std::size_t) noexcept -> decltype(p.pitch())
+        {
+            return p.pitch();
+        }
+
+        inline auto address_of(const void* p) noexcept -> const void*
+        {
+            return p;
+        }
+
+        /* pitched pointers */
+        template <class Pointer>
+        auto address_of(const Pointer& p) noexcept -> decltype(static_cast<const void*>(p.ptr()))
+        {
+            return p.ptr();
+        }
+    }
+
+    /*
+     * Deleter of the smart pointers handed out by the pools: returns the buffer
+     * to its pool instead of freeing it. It stores everything needed to rebuild
+     * the pool's pointer type, so releasing a pooled buffer is a direct call
+     * without type erasure or heap allocation.
+     *
+     * Deliberately has no member called pointer, std::unique_ptr would pick it up.
+     */
+    template <class T, class Pool>
+    class pool_deleter
+    {
+        public:
+            pool_deleter() noexcept
+            : pool_{nullptr}, pitch_{0}, extents_{0, 0, 0}
+            {}
+
+            pool_deleter(Pool* pool, std::size_t pitch, pool_shape extents) noexcept
+            : pool_{pool}, pitch_{pitch}, extents_(extents)
+            {}
+
+            auto operator()(T* p) const noexcept -> void
+            {
+                using pool_pointer = typename Pool::pointer;
+                if(pool_ != nullptr && p != nullptr)
+                    pool_->deallocate(detail::make_pool_pointer<pool_pointer>(p, pitch_, std::is_pointer<pool_pointer>{}));
+            }
+
+            auto pool() const noexcept -> Pool* { return pool_; }
+            auto pitch() const noexcept -> std::size_t { return pitch_; }
+            auto extents() const noexcept -> pool_shape { return extents_; }
+
+        private:
+            Pool* pool_;
+            std::size_t pitch_;
+            pool_shape extents_;
+    };
+}
+
+#endif /* GLADOS_BITS_POOL_DELETER_H_ */
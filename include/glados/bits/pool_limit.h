@@ -0,0 +1,176 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_LIMIT_H_
+#define GLADOS_BITS_POOL_LIMIT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Counts the buffers a pool has handed out and blocks callers once the
+         * limit is reached. Waiting threads sleep on a condition variable and
+         * are woken by release(); as long as nobody waits, release() does not
+         * touch the mutex. A limit of 0 means unlimited, in which case nothing
+         * is counted at all. The time spent waiting is recorded on the slow path
+         * only.
+         */
+        class pool_limit
+        {
+            private:
+                using lock_type = std::unique_lock<std::mutex>;
+
+            public:
+                using clock_type = std::chrono::steady_clock;
+
+                struct wait_times
+                {
+                    std::size_t waits;
+                    clock_type::duration total;
+                    clock_type::duration max;
+                };
+
+            public:
+                explicit pool_limit(std::size_t limit = 0) noexcept
+                : limit_{limit}, current_{0}, waiters_{0}, times_{0, clock_type::duration::zero(), clock_type::duration::zero()}
+                {}
+
+                /* not thread-safe, like the move operations of the owning pool */
+                pool_limit(pool_limit&& other) noexcept
+                : limit_{other.limit_}, current_{other.current_.load()}, waiters_{0}, times_{other.times_}
+                {}
+
+                auto operator=(pool_limit&& other) noexcept -> pool_limit&
+                {
+                    limit_ = other.limit_;
+                    current_ = other.current_.load();
+                    times_ = other.times_;
+                    return *this;
+                }
+
+                auto acquire() -> void
+                {
+                    if(try_acquire())
+                        return;
+
+                    auto start = clock_type::now();
+                    auto&& lock = lock_type{mutex_};
+                    ++waiters_;
+                    cv_.wait(lock, [this]() { return try_acquire(); });
+                    --waiters_;
+                    record_wait(clock_type::now() - start);
+                }
+
+                auto try_acquire() noexcept -> bool
+                {
+                    if(limit_ == 0)
+                        return true;
+
+                    auto cur = current_.load();
+                    while(cur < limit_)
+                    {
+                        if(current_.compare_exchange_weak(cur, cur + 1))
+                            return true;
+                    }
+                    return false;
+                }
+
+                template <class Rep, class Period>
+                auto try_acquire_for(const std::chrono::duration<Rep, Period>& timeout) -> bool
+                {
+                    if(try_acquire())
+                        return true;
+
+                    auto start = clock_type::now();
+                    auto&& lock = lock_type{mutex_};
+                    ++waiters_;
+                    auto ret = cv_.wait_for(lock, timeout, [this]() { return try_acquire(); });
+                    --waiters_;
+                    record_wait(clock_type::now() - start);
+                    return ret;
+                }
+
+                auto release() noexcept -> void
+                {
+                    if(limit_ == 0)
+                        return;
+
+                    --current_;
+                    // the waiter registers before checking the counter, so one of us sees the other
+                    if(waiters_.load() != 0)
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        cv_.notify_one();
+                    }
+                }
+
+                /* forgets all outstanding buffers */
+                auto reset() noexcept -> void
+                {
+                    current_.store(0);
+                    if(waiters_.load() != 0)
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        cv_.notify_all();
+                    }
+                }
+
+                auto limit() const noexcept -> std::size_t { return limit_; }
+
+                /* only counted if there is a limit */
+                auto outstanding() const noexcept -> std::size_t { return current_.load(); }
+
+                auto waited() -> wait_times
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return times_;
+                }
+
+            private:
+                /* called with mutex_ held */
+                auto record_wait(clock_type::duration d) noexcept -> void
+                {
+                    ++times_.waits;
+                    times_.total += d;
+                    if(d > times_.max)
+                        times_.max = d;
+                }
+
+            private:
+                std::size_t limit_;
+                std::atomic<std::size_t> current_;
+                std::atomic<std::size_t> waiters_;
+                std::mutex mutex_;
+                std::condition_variable cv_;
+                wait_times times_;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_LIMIT_H_ */
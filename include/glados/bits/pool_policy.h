@@ -0,0 +1,113 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_POLICY_H_
+#define GLADOS_BITS_POOL_POLICY_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace glados
+{
+    class memory_budget;
+
+    /*
+     * How a pool deals with idle buffers. A value of zero disables the
+     * respective limit. Buffers above max_idle_buffers or max_idle_bytes are
+     * returned to the internal allocator, as are buffers which stayed unused
+     * for max_idle_age; the limits are enforced by trim() and, for the shared
+     * depot, automatically whenever a thread's cache overflows into it.
+     *
+     * An owning pool releases its buffers on destruction. Its destructor waits
+     * until all outstanding buffers have been returned, so every buffer has to
+     * be given back before the pool goes away. A non-zero close_timeout bounds
+     * that wait: buffers still outstanding afterwards are abandoned (and assert
+     * in debug builds), returning them later is undefined behaviour.
+     *
+     * A NUMA-aware pool keeps its idle buffers per node: new buffers are
+     * first-touched on the node of the allocating thread, returned buffers go
+     * back to their home node and allocations prefer buffers of the caller's
+     * node. Only useful for host memory on multi-socket machines.
+     *
+     * With a budget, every buffer the pool creates is charged to it and the
+     * budget may take idle buffers away when others run short.
+     */
+    struct pool_policy
+    {
+        std::size_t max_idle_buffers = 0;
+        std::size_t max_idle_bytes = 0;
+        std::chrono::steady_clock::duration max_idle_age = std::chrono::steady_clock::duration::zero();
+        bool owning = false;
+        std::chrono::steady_clock::duration close_timeout = std::chrono::steady_clock::duration::zero();
+        bool numa_aware = false;
+        memory_budget* budget = nullptr;
+    };
+
+    namespace detail
+    {
+        inline auto trims(const pool_policy& p) noexcept -> bool
+        {
+            return p.max_idle_buffers != 0 || p.max_idle_bytes != 0 || p.max_idle_age != std::chrono::steady_clock::duration::zero();
+        }
+
+        /* number of idle buffers the policy allows, SIZE_MAX if unlimited */
+        inline auto idle_allowance(const pool_policy& p, std::size_t buffer_bytes) noexcept -> std::size_t
+        {
+            auto allowed = static_cast<std::size_t>(-1);
+            if(p.max_idle_buffers != 0)
+                allowed = p.max_idle_buffers;
+            if(p.max_idle_bytes != 0 && buffer_bytes != 0)
+                allowed = std::min(allowed, p.max_idle_bytes / buffer_bytes);
+            return allowed;
+        }
+
+        /* tells when the next max_idle_age period has passed */
+        class idle_age_timer
+        {
+            public:
+                using clock_type = std::chrono::steady_clock;
+
+                idle_age_timer() noexcept
+                : last_{clock_type::now()}
+                {}
+
+                auto due(const pool_policy& p) noexcept -> bool
+                {
+                    if(p.max_idle_age == clock_type::duration::zero())
+                        return false;
+
+                    auto now = clock_type::now();
+                    if(now - last_ < p.max_idle_age)
+                        return false;
+
+                    last_ = now;
+                    return true;
+                }
+
+            private:
+                clock_type::time_point last_;
+        };
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_POLICY_H_ */
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_SHAPE_H_
+#define GLADOS_BITS_POOL_SHAPE_H_
+
+#include <cstddef>
+
+namespace glados
+{
+    /* extents of a pooled buffer, unused dimensions are 1 */
+    struct pool_shape
+    {
+        std::size_t x;
+        std::size_t y;
+        std::size_t z;
+    };
+
+    inline auto operator==(const pool_shape& a, const pool_shape& b) noexcept -> bool
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    inline auto operator!=(const pool_shape& a, const pool_shape& b) noexcept -> bool
+    {
+        return !(a == b);
+    }
+}
+
+#endif /* GLADOS_BITS_POOL_SHAPE_H_ */
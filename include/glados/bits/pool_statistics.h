@@ -0,0 +1,52 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_POOL_STATISTICS_H_
+#define GLADOS_BITS_POOL_STATISTICS_H_
+
+#include <chrono>
+#include <cstddef>
+
+namespace glados
+{
+    /* snapshot of a pool's counters, see pool_allocator::statistics() */
+    struct pool_statistics
+    {
+        std::size_t hits;           // allocations served with an idle buffer
+        std::size_t misses;         // allocations which needed InternalAlloc::allocate()
+        std::size_t outstanding;    // buffers currently handed out
+        std::size_t high_water;     // maximum number of buffers the pool owned at the same time
+        std::size_t idle_buffers;   // buffers waiting for reuse
+        std::size_t idle_bytes;     // memory held by idle buffers, without pitch padding
+        std::size_t waits;          // allocations which had to wait for the limit
+        std::chrono::nanoseconds total_wait;
+        std::chrono::nanoseconds max_wait;
+
+        auto hit_ratio() const noexcept -> double
+        {
+            auto total = hits + misses;
+            return (total == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+    };
+}
+
+#endif /* GLADOS_BITS_POOL_STATISTICS_H_ */
@@ -0,0 +1,453 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_BITS_SIZE_CLASS_POOL_ALLOCATOR_H_
+#define GLADOS_BITS_SIZE_CLASS_POOL_ALLOCATOR_H_
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/pool_deleter.h>
+#include <glados/bits/pool_shape.h>
+
+namespace glados
+{
+    namespace detail
+    {
+        /*
+         * Rounds n up to the next size class. Classes are spaced a quarter of a
+         * power of two apart (…, 64, 80, 96, 112, 128, 160, …), so a buffer is at
+         * most 25% larger than requested.
+         */
+        inline auto size_class(std::size_t n) noexcept -> std::size_t
+        {
+            if(n <= 4)
+                return n;
+
+            auto msb = 63 - __builtin_clzll(static_cast<unsigned long long>(n));
+            auto step = std::size_t{1} << (msb - 2);
+            return (n + step - 1) / step * step;
+        }
+
+        struct pool_shape_hash
+        {
+            auto operator()(const pool_shape& s) const noexcept -> std::size_t
+            {
+                auto h = std::hash<std::size_t>{};
+                auto seed = h(s.x);
+                seed ^= h(s.y) + 0x9e3779b97f4a7c15u + (seed << 6) + (seed >> 2);
+                seed ^= h(s.z) + 0x9e3779b97f4a7c15u + (seed << 6) + (seed >> 2);
+                return seed;
+            }
+        };
+
+        /*
+         * Idle buffers bucketed by size class plus the shape of every buffer the
+         * pool has created, so returned buffers find their bucket again.
+         */
+        template <class Pointer>
+        class size_class_store
+        {
+            private:
+                using lock_type = std::lock_guard<std::mutex>;
+
+            public:
+                size_class_store() = default;
+
+                /* not thread-safe, like the move operations of the owning pool */
+                size_class_store(size_class_store&& other) noexcept
+                : idle_{std::move(other.idle_)}, counts_{std::move(other.counts_)}, shapes_{std::move(other.shapes_)}
+                {}
+
+                auto operator=(size_class_store&& other) noexcept -> size_class_store&
+                {
+                    idle_ = std::move(other.idle_);
+                    counts_ = std::move(other.counts_);
+                    shapes_ = std::move(other.shapes_);
+                    return *this;
+                }
+
+                auto take(const pool_shape& cls, Pointer& p) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    auto it = idle_.find(cls);
+                    if(it == std::end(idle_) || it->second.empty())
+                        return false;
+
+                    p = it->second.back();
+                    it->second.pop_back();
+                    return true;
+                }
+
+                /* leaves the store unchanged if it throws */
+                auto track(const Pointer& p, const pool_shape& cls) -> void
+                {
+                    auto&& lock = lock_type{mutex_};
+                    // reserve the bucket slot now, give_back() must not throw
+                    auto& bucket = idle_[cls];
+                    auto& count = counts_[cls];
+                    bucket.reserve(count + 1);
+                    shapes_[address_of(p)] = cls;
+                    ++count;
+                }
+
+                /* false if p was not created by this pool */
+                auto give_back(const Pointer& p) noexcept -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    auto it = shapes_.find(address_of(p));
+                    if(it == std::end(shapes_))
+                        return false;
+
+                    idle_[it->second].push_back(p);
+                    return true;
+                }
+
+                auto shape_of(const Pointer& p) const -> pool_shape
+                {
+                    auto&& lock = lock_type{mutex_};
+                    auto it = shapes_.find(address_of(p));
+                    return (it == std::end(shapes_)) ? pool_shape{0, 0, 0} : it->second;
+                }
+
+                /* hands every idle buffer and its shape to f and forgets about it */
+                template <class F>
+                auto drain(F&& f) noexcept -> void
+                {
+                    auto&& lock = lock_type{mutex_};
+                    for(auto&& bucket : idle_)
+                    {
+                        for(auto&& p : bucket.second)
+                        {
+                            f(p, bucket.first);
+                            shapes_.erase(address_of(p));
+                        }
+                        counts_[bucket.first] -= bucket.second.size();
+                        bucket.second.clear();
+                    }
+                }
+
+            private:
+                mutable std::mutex mutex_;
+                std::unordered_map<pool_shape, std::vector<Pointer>, pool_shape_hash> idle_;
+                std::unordered_map<pool_shape, std::size_t, pool_shape_hash> counts_;
+                std::unordered_map<const void*, pool_shape> shapes_;
+        };
+    }
+
+    /*
+     * Pool for buffers of different shapes. Requests are rounded up to size
+     * classes (see detail::size_class) and served from the bucket of that
+     * class; shape() reports the extents a buffer actually has. Layouts which
+     * do not need a pitch are bucketed by their rounded element count (their
+     * shape is {elements, 1, 1}), pitched layouts by their rounded extents.
+     */
+    template <class T, memory_layout ml, class InternalAlloc, class = typename std::enable_if<(ml == InternalAlloc::mem_layout)>::type>
+    class size_class_pool_allocator {};
+
+    /* 1D specialization */
+    template <class T, class InternalAlloc>
+    class size_class_pool_allocator<T, memory_layout::pointer_1D, InternalAlloc>
+    {
+        public:
+            static constexpr auto mem_layout = InternalAlloc::mem_layout;
+            static constexpr auto mem_location = InternalAlloc::mem_location;
+            static constexpr auto alloc_needs_pitch = InternalAlloc::alloc_needs_pitch;
+
+            using value_type = T;
+            using pointer = typename InternalAlloc::pointer;
+            using const_pointer = typename InternalAlloc::const_pointer;
+            using size_type = typename InternalAlloc::size_type;
+            using difference_type = typename InternalAlloc::difference_type;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+            using is_always_equal = std::true_type;
+            using deleter_type = pool_deleter<T, size_class_pool_allocator>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
+
+            template <class U>
+            struct rebind
+            {
+                using other = size_class_pool_allocator<U, mem_layout, InternalAlloc>;
+            };
+
+        public:
+            size_class_pool_allocator() = default;
+            size_class_pool_allocator(size_class_pool_allocator&& other) noexcept = default;
+            auto operator=(size_class_pool_allocator&& other) noexcept -> size_class_pool_allocator& = default;
+
+            size_class_pool_allocator(const size_class_pool_allocator& other) noexcept = delete;
+            auto operator=(const size_class_pool_allocator& other) noexcept -> size_class_pool_allocator& = delete;
+
+            ~size_class_pool_allocator()
+            {
+                // like pool_allocator, the contents have to be released manually
+            }
+
+            auto allocate(size_type n) -> pointer
+            {
+                auto cls = pool_shape{detail::size_class(n), 1, 1};
+
+                auto ret = static_cast<pointer>(nullptr);
+                if(!store_.take(cls, ret))
+                {
+                    ret = alloc_.allocate(cls.x);
+                    try
+                    {
+                        store_.track(ret, cls);
+                    }
+                    catch(...)
+                    {
+                        alloc_.deallocate(ret, cls.x);
+                        throw;
+                    }
+                }
+                return ret;
+            }
+
+            auto allocate_smart(size_type n) -> smart_pointer
+            {
+                auto p = allocate(n);
+                return smart_pointer{p, deleter_type{this, detail::pitch_of(p, n * sizeof(T)), pool_shape{n, 1, 1}}};
+            }
+
+            /* a buffer this pool did not create goes to InternalAlloc with the extents passed here */
+            auto deallocate(pointer p, size_type n = 0) noexcept -> void
+            {
+                if(p == nullptr)
+                    return;
+
+                if(!store_.give_back(p))
+                    alloc_.deallocate(p, n);
+            }
+
+            auto shape(pointer p) const -> pool_shape
+            {
+                return store_.shape_of(p);
+            }
+
+            auto release() noexcept -> void
+            {
+                store_.drain([this](pointer& p, const pool_shape& s) { alloc_.deallocate(p, s.x); });
+            }
+
+        private:
+            InternalAlloc alloc_;
+            detail::size_class_store<pointer> store_;
+    };
+
+    /* 2D specialization */
+    template <class T, class InternalAlloc>
+    class size_class_pool_allocator<T, memory_layout::pointer_2D, InternalAlloc>
+    {
+        public:
+            static constexpr auto mem_layout = InternalAlloc::mem_layout;
+            static constexpr auto mem_location = InternalAlloc::mem_location;
+            static constexpr auto alloc_needs_pitch = InternalAlloc::alloc_needs_pitch;
+
+            using value_type = T;
+            using pointer = typename InternalAlloc::pointer;
+            using const_pointer = typename InternalAlloc::const_pointer;
+            using size_type = typename InternalAlloc::size_type;
+            using difference_type = typename InternalAlloc::difference_type;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+            using is_always_equal = std::true_type;
+            using deleter_type = pool_deleter<T, size_class_pool_allocator>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
+
+            template <class U>
+            struct rebind
+            {
+                using other = size_class_pool_allocator<U, mem_layout, InternalAlloc>;
+            };
+
+        public:
+            size_class_pool_allocator() = default;
+            size_class_pool_allocator(size_class_pool_allocator&& other) noexcept = default;
+            auto operator=(size_class_pool_allocator&& other) noexcept -> size_class_pool_allocator& = default;
+
+            size_class_pool_allocator(const size_class_pool_allocator& other) noexcept = delete;
+            auto operator=(const size_class_pool_allocator& other) noexcept -> size_class_pool_allocator& = delete;
+
+            ~size_class_pool_allocator()
+            {
+                // like pool_allocator, the contents have to be released manually
+            }
+
+            auto allocate(size_type x, size_type y) -> pointer
+            {
+                // dense buffers only need enough elements, pitched ones enough rows of enough width
+                auto cls = alloc_needs_pitch ? pool_shape{detail::size_class(x), detail::size_class(y), 1}
+                                             : pool_shape{detail::size_class(x * y), 1, 1};
+
+                auto ret = static_cast<pointer>(nullptr);
+                if(!store_.take(cls, ret))
+                {
+                    ret = alloc_.allocate(cls.x, cls.y);
+                    try
+                    {
+                        store_.track(ret, cls);
+                    }
+                    catch(...)
+                    {
+                        alloc_.deallocate(ret, cls.x, cls.y);
+                        throw;
+                    }
+                }
+                return ret;
+            }
+
+            auto allocate_smart(size_type x, size_type y) -> smart_pointer
+            {
+                auto p = allocate(x, y);
+                return smart_pointer{p, deleter_type{this, detail::pitch_of(p, x * sizeof(T)), pool_shape{x, y, 1}}};
+            }
+
+            /* a buffer this pool did not create goes to InternalAlloc with the extents passed here */
+            auto deallocate(pointer p, size_type x = 0, size_type y = 0) noexcept -> void
+            {
+                if(p == nullptr)
+                    return;
+
+                if(!store_.give_back(p))
+                    alloc_.deallocate(p, x, y);
+            }
+
+            auto shape(pointer p) const -> pool_shape
+            {
+                return store_.shape_of(p);
+            }
+
+            auto release() noexcept -> void
+            {
+                store_.drain([this](pointer& p, const pool_shape& s) { alloc_.deallocate(p, s.x, s.y); });
+            }
+
+        private:
+            InternalAlloc alloc_;
+            detail::size_class_store<pointer> store_;
+    };
+
+    /* 3D specialization */
+    template <class T, class InternalAlloc>
+    class size_class_pool_allocator<T, memory_layout::pointer_3D, InternalAlloc>
+    {
+        public:
+            static constexpr auto mem_layout = InternalAlloc::mem_layout;
+            static constexpr auto mem_location = InternalAlloc::mem_location;
+            static constexpr auto alloc_needs_pitch = InternalAlloc::alloc_needs_pitch;
+
+            using value_type = T;
+            using pointer = typename InternalAlloc::pointer;
+            using const_pointer = typename InternalAlloc::const_pointer;
+            using size_type = typename InternalAlloc::size_type;
+            using difference_type = typename InternalAlloc::difference_type;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+            using is_always_equal = std::true_type;
+            using deleter_type = pool_deleter<T, size_class_pool_allocator>;
+            using smart_pointer = typename InternalAlloc::template smart_pointer<deleter_type>;
+
+            template <class U>
+            struct rebind
+            {
+                using other = size_class_pool_allocator<U, mem_layout, InternalAlloc>;
+            };
+
+        public:
+            size_class_pool_allocator() = default;
+            size_class_pool_allocator(size_class_pool_allocator&& other) noexcept = default;
+            auto operator=(size_class_pool_allocator&& other) noexcept -> size_class_pool_allocator& = default;
+
+            size_class_pool_allocator(const size_class_pool_allocator& other) noexcept = delete;
+            auto operator=(const size_class_pool_allocator& other) noexcept -> size_class_pool_allocator& = delete;
+
+            ~size_class_pool_allocator()
+            {
+                // like pool_allocator, the contents have to be released manually
+            }
+
+            auto allocate(size_type x, size_type y, size_type z) -> pointer
+            {
+                auto cls = alloc_needs_pitch ? pool_shape{detail::size_class(x), detail::size_class(y), detail::size_class(z)}
+                                             : pool_shape{detail::size_class(x * y * z), 1, 1};
+
+                auto ret = static_cast<pointer>(nullptr);
+                if(!store_.take(cls, ret))
+                {
+                    ret = alloc_.allocate(cls.x, cls.y, cls.z);
+                    try
+                    {
+                        store_.track(ret, cls);
+                    }
+                    catch(...)
+                    {
+                        alloc_.deallocate(ret, cls.x, cls.y, cls.z);
+                        throw;
+                    }
+                }
+                return ret;
+            }
+
+            auto allocate_smart(size_type x, size_type y, size_type z) -> smart_pointer
+            {
+                auto p = allocate(x, y, z);
+                return smart_pointer{p, deleter_type{this, detail::pitch_of(p, x * sizeof(T)), pool_shape{x, y, z}}};
+            }
+
+            /* a buffer this pool did not create goes to InternalAlloc with the extents passed here */
+            auto deallocate(pointer p, size_type x = 0, size_type y = 0, size_type z = 0) noexcept -> void
+            {
+                if(p == nullptr)
+                    return;
+
+                if(!store_.give_back(p))
+                    alloc_.deallocate(p, x, y, z);
+            }
+
+            auto shape(pointer p) const -> pool_shape
+            {
+                return store_.shape_of(p);
+            }
+
+            auto release() noexcept -> void
+            {
+                store_.drain([this](pointer& p, const pool_shape& s) { alloc_.deallocate(p, s.x, s.y, s.z); });
+            }
+
+        private:
+            InternalAlloc alloc_;
+            detail::size_class_store<pointer> store_;
+    };
+}
+
+#endif /* GLADOS_BITS_SIZE_CLASS_POOL_ALLOCATOR_H_ */
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_BITS_STRIDED_VIEW_H_
+#define GLADOS_BITS_STRIDED_VIEW_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include <glados/bits/memory_location.h>
+
+namespace glados
+{
+    /*
+     * Non-owning window into a 1D, 2D or 3D buffer. A view stores the extents
+     * of the window, the row pitch in bytes and the number of rows between two
+     * slices of the underlying buffer, so sub-volumes, slices and single rows
+     * can be handed to other stages without copying. Views provide the same
+     * interface as glados::cuda::unique_ptr (element_type, mem_location,
+     * pitched_memory, pinned_memory, get(), pitch()) and can therefore be used
+     * with the copy and fill policies directly.
+     *
+     * The view does not keep the buffer alive; the owner has to outlive it.
+     */
+    template <class T, std::size_t Rank, memory_location loc, bool pinned = false>
+    class strided_view
+    {
+        static_assert(Rank >= 1 && Rank <= 3, "Views support 1 to 3 dimensions");
+
+        public:
+            using element_type = T;
+            using pointer = T*;
+
+            static constexpr auto rank = Rank;
+            static constexpr auto mem_location = loc;
+            static constexpr auto pitched_memory = (Rank > 1);
+            static constexpr auto pinned_memory = pinned;
+
+        public:
+            constexpr strided_view() noexcept
+            : ptr_{nullptr}, x_{0}, y_{0}, z_{0}, pitch_{0}, rows_{0}
+            {}
+
+            /* pitch is given in bytes, rows is the distance between two slices in rows */
+            strided_view(pointer p, std::size_t x, std::size_t y = 1, std::size_t z = 1, std::size_t pitch = 0, std::size_t rows = 0) noexcept
+            : ptr_{p}, x_{x}, y_{y}, z_{z}, pitch_{pitch == 0 ? x * sizeof(T) : pitch}, rows_{rows == 0 ? y : rows}
+            {}
+
+            /* views of T convert to views of const T */
+            template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            strided_view(const strided_view<U, Rank, loc, pinned>& other) noexcept
+            : ptr_{other.get()}, x_{other.x()}, y_{other.y()}, z_{other.z()}, pitch_{other.row_pitch()}, rows_{other.rows()}
+            {}
+
+            auto get() const noexcept -> pointer { return ptr_; }
+
+            /* like unique_ptr, non-pitched (1D) views report a pitch of 0 */
+            auto pitch() const noexcept -> std::size_t { return pitched_memory ? pitch_ : 0; }
+
+            auto row_pitch() const noexcept -> std::size_t { return pitch_; }
+            auto slice_pitch() const noexcept -> std::size_t { return pitch_ * rows_; }
+            auto rows() const noexcept -> std::size_t { return rows_; }
+
+            auto x() const noexcept -> std::size_t { return x_; }
+            auto y() const noexcept -> std::size_t { return y_; }
+            auto z() const noexcept -> std::size_t { return z_; }
+
+            explicit operator bool() const noexcept
+            {
+                return ptr_ != nullptr;
+            }
+
+            /* element address, only dereference it if the memory is accessible from the calling side */
+            auto address(std::size_t x, std::size_t y = 0, std::size_t z = 0) const noexcept -> pointer
+            {
+                using byte = typename std::conditional<std::is_const<T>::value, const unsigned char, unsigned char>::type;
+                auto bytes = reinterpret_cast<byte*>(ptr_);
+                return reinterpret_cast<pointer>(bytes + z * slice_pitch() + y * pitch_) + x;
+            }
+
+            auto operator()(std::size_t x, std::size_t y = 0, std::size_t z = 0) const noexcept -> T&
+            {
+                static_assert(loc == memory_location::host, "Elements of device views cannot be accessed on the host");
+                return *address(x, y, z);
+            }
+
+            /* window of nx * ny * nz elements starting at (off_x, off_y, off_z) */
+            auto subview(std::size_t off_x, std::size_t off_y, std::size_t off_z,
+                         std::size_t nx, std::size_t ny, std::size_t nz) const noexcept -> strided_view
+            {
+                return strided_view{address(off_x, off_y, off_z), nx, ny, nz, pitch_, rows_};
+            }
+
+            auto subview(std::size_t off_x, std::size_t off_y, std::size_t nx, std::size_t ny) const noexcept -> strided_view
+            {
+                return subview(off_x, off_y, 0, nx, ny, z_);
+            }
+
+            auto subview(std::size_t off_x, std::size_t nx) const noexcept -> strided_view
+            {
+                return subview(off_x, 0, 0, nx, y_, z_);
+            }
+
+            /* the 2D plane at depth z */
+            auto slice(std::size_t z) const noexcept -> strided_view<T, 2, loc, pinned>
+            {
+                static_assert(Rank == 3, "Only 3D views can be sliced");
+                return strided_view<T, 2, loc, pinned>{address(0, 0, z), x_, y_, 1, pitch_, rows_};
+            }
+
+            /* a single contiguous row */
+            auto row(std::size_t y, std::size_t z = 0) const noexcept -> strided_view<T, 1, loc, pinned>
+            {
+                static_assert(Rank > 1, "1D views have a single row only");
+                return strided_view<T, 1, loc, pinned>{address(0, y, z), x_};
+            }
+
+        private:
+            pointer ptr_;
+            std::size_t x_, y_, z_;
+            std::size_t pitch_;
+            std::size_t rows_;
+    };
+
+    namespace detail
+    {
+        template <class P>
+        auto view_pitch(const P& p, std::size_t x, std::true_type) noexcept -> std::size_t
+        {
+            static_cast<void>(x);
+            return p.pitch();
+        }
+
+        template <class P>
+        auto view_pitch(const P&, std::size_t x, std::false_type) noexcept -> std::size_t
+        {
+            return x * sizeof(typename P::element_type);
+        }
+
+        template <class P, std::size_t Rank>
+        using view_of = strided_view<typename P::element_type, Rank, P::mem_location, P::pinned_memory>;
+    }
+
+    /*
+     * Views over glados::cuda::unique_ptr and pooled buffers.
+     * x, y and z are the extents of the underlying buffer.
+     */
+    template <class P>
+    auto make_view(const P& p, std::size_t x) noexcept -> detail::view_of<P, 1>
+    {
+        return detail::view_of<P, 1>{p.get(), x};
+    }
+
+    template <class P>
+    auto make_view(const P& p, std::size_t x, std::size_t y) noexcept -> detail::view_of<P, 2>
+    {
+        auto pitch = detail::view_pitch(p, x, std::integral_constant<bool, P::pitched_memory>{});
+        return detail::view_of<P, 2>{p.get(), x, y, 1, pitch};
+    }
+
+    template <class P>
+    auto make_view(const P& p, std::size_t x, std::size_t y, std::size_t z) noexcept -> detail::view_of<P, 3>
+    {
+        auto pitch = detail::view_pitch(p, x, std::integral_constant<bool, P::pitched_memory>{});
+        return detail::view_of<P, 3>{p.get(), x, y, z, pitch};
+    }
+
+    /* views over host memory owned by std::unique_ptr, e.g. from generic::allocator */
+    template <class T, class D>
+    auto make_view(const std::unique_ptr<T[], D>& p, std::size_t x) noexcept -> strided_view<T, 1, memory_location::host>
+    {
+        return strided_view<T, 1, memory_location::host>{p.get(), x};
+    }
+
+    template <class T, class D>
+    auto make_view(const std::unique_ptr<T[], D>& p, std::size_t x, std::size_t y) noexcept -> strided_view<T, 2, memory_location::host>
+    {
+        return strided_view<T, 2, memory_location::host>{p.get(), x, y};
+    }
+
+    template <class T, class D>
+    auto make_view(const std::unique_ptr<T[], D>& p, std::size_t x, std::size_t y, std::size_t z) noexcept -> strided_view<T, 3, memory_location::host>
+    {
+        return strided_view<T, 3, memory_location::host>{p.get(), x, y, z};
+    }
+}
+
+#endif /* GLADOS_BITS_STRIDED_VIEW_H_ */
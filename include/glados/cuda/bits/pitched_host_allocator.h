@@ -0,0 +1,214 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_CUDA_BITS_PITCHED_HOST_ALLOCATOR_H_
+#define GLADOS_CUDA_BITS_PITCHED_HOST_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include <glados/bits/array_size.h>
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+#include <glados/cuda/bits/pitched_ptr.h>
+#include <glados/cuda/bits/unique_ptr.h>
+
+namespace glados
+{
+    namespace cuda
+    {
+        namespace detail
+        {
+            constexpr auto host_row_alignment = std::size_t{64};
+
+            /*
+             * Row pitch for pitched host memory: rows start on a cache line and a
+             * pitch which is a multiple of 1 KiB gets one extra cache line, so
+             * that column-wise access over power-of-two wide rows does not map
+             * every row to the same cache sets (and 4K-aliases with itself).
+             * Throws std::bad_array_new_length if the pitch does not fit into
+             * std::size_t.
+             */
+            inline auto host_pitch(std::size_t row_bytes) -> std::size_t
+            {
+                auto pitch = glados::detail::padded_size(row_bytes, host_row_alignment - 1) / host_row_alignment * host_row_alignment;
+                if(pitch % 1024 == 0)
+                    pitch = glados::detail::padded_size(pitch, host_row_alignment);
+                return pitch;
+            }
+
+            inline auto allocate_pitched_host(std::size_t bytes) -> void*
+            {
+                auto p = static_cast<void*>(nullptr);
+                if(::posix_memalign(&p, host_row_alignment, bytes == 0 ? 1 : bytes) != 0)
+                    throw std::bad_alloc{};
+                return p;
+            }
+        }
+
+        struct pitched_host_deleter { auto operator()(void* p) noexcept -> void { std::free(p); }};
+
+        template <class T>
+        using pitched_host_ptr = unique_ptr<T, pitched_host_deleter, true, memory_location::host, false>;
+
+        template <class T>
+        auto make_unique_pitched_host(std::size_t x, std::size_t y) -> pitched_host_ptr<T>
+        {
+            auto pitch = detail::host_pitch(glados::detail::array_size(x, sizeof(T)));
+            auto ptr = static_cast<T*>(detail::allocate_pitched_host(glados::detail::array_size(pitch, y)));
+            return pitched_host_ptr<T>{pitched_ptr<T>{ptr, pitch}};
+        }
+
+        template <class T>
+        auto make_unique_pitched_host(std::size_t x, std::size_t y, std::size_t z) -> pitched_host_ptr<T>
+        {
+            auto pitch = detail::host_pitch(glados::detail::array_size(x, sizeof(T)));
+            auto ptr = static_cast<T*>(detail::allocate_pitched_host(glados::detail::array_size(pitch, y, z)));
+            return pitched_host_ptr<T>{pitched_ptr<T>{ptr, pitch}};
+        }
+
+        /*
+         * Pageable host memory with padded rows, see detail::host_pitch(). Like
+         * the device allocators it hands out pitched_ptrs, the elements are left
+         * uninitialized.
+         */
+        template <class T, memory_layout ml>
+        class pitched_host_allocator {};
+
+        template <class T>
+        class pitched_host_allocator<T, memory_layout::pointer_2D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = true;
+
+                using value_type = T;
+                using pointer = pitched_ptr<value_type>;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = unique_ptr<T, Deleter, alloc_needs_pitch, mem_location, false>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = pitched_host_allocator<U, mem_layout>;
+                };
+
+                pitched_host_allocator() noexcept = default;
+                pitched_host_allocator(const pitched_host_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                pitched_host_allocator(const pitched_host_allocator<U, uml>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible host allocator");
+                }
+
+                ~pitched_host_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    auto pitch = detail::host_pitch(glados::detail::array_size(x, sizeof(value_type)));
+                    return pointer{static_cast<value_type*>(detail::allocate_pitched_host(glados::detail::array_size(pitch, y))), pitch};
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    std::free(p.ptr());
+                }
+        };
+
+        template <class T>
+        class pitched_host_allocator<T, memory_layout::pointer_3D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = true;
+
+                using value_type = T;
+                using pointer = pitched_ptr<value_type>;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = unique_ptr<T, Deleter, alloc_needs_pitch, mem_location, false>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = pitched_host_allocator<U, mem_layout>;
+                };
+
+                pitched_host_allocator() noexcept = default;
+                pitched_host_allocator(const pitched_host_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                pitched_host_allocator(const pitched_host_allocator<U, uml>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible host allocator");
+                }
+
+                ~pitched_host_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    auto pitch = detail::host_pitch(glados::detail::array_size(x, sizeof(value_type)));
+                    return pointer{static_cast<value_type*>(detail::allocate_pitched_host(glados::detail::array_size(pitch, y, z))), pitch};
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    std::free(p.ptr());
+                }
+        };
+
+        template <class T1, memory_layout ml1, class T2, memory_layout ml2>
+        auto operator==(const pitched_host_allocator<T1, ml1>&, const pitched_host_allocator<T2, ml2>&) noexcept -> bool
+        {
+            return true;
+        }
+
+        template <class T1, memory_layout ml1, class T2, memory_layout ml2>
+        auto operator!=(const pitched_host_allocator<T1, ml1>&, const pitched_host_allocator<T2, ml2>&) noexcept -> bool
+        {
+            return false;
+        }
+    }
+}
+
+#endif /* GLADOS_CUDA_BITS_PITCHED_HOST_ALLOCATOR_H_ */
@@ -29,8 +29,10 @@
 #include <cuda_runtime.h>
 #endif
 
+#include <glados/bits/strided_view.h>
 #include <glados/cuda/bits/device_allocator.h>
 #include <glados/cuda/bits/host_allocator.h>
+#include <glados/cuda/bits/pitched_host_allocator.h>
 #include <glados/cuda/bits/pitched_ptr.h>
 #include <glados/cuda/bits/throw_error.h>
 #include <glados/cuda/bits/unique_ptr.h>
@@ -28,6 +28,7 @@
 #include <exception>
 #include <future>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 #ifndef __CUDACC__
@@ -45,6 +46,37 @@ namespace glados
     {
         namespace detail
         {
+            /* rows between two slices: strided views may be windows into taller volumes */
+            template <class P>
+            auto slice_rows(const P& p, std::size_t, int) -> decltype(p.rows())
+            {
+                return p.rows();
+            }
+
+            template <class P>
+            auto slice_rows(const P&, std::size_t y, long) -> std::size_t
+            {
+                return y;
+            }
+
+            template <class P>
+            auto fill_host(P& p, int value, std::size_t x, std::size_t y, std::size_t z, std::false_type) -> void
+            {
+                std::fill_n(p.get(), x * y * z, value);
+            }
+
+            /* pitched host memory: the padding at the end of each row is left alone */
+            template <class P>
+            auto fill_host(P& p, int value, std::size_t x, std::size_t y, std::size_t z, std::true_type) -> void
+            {
+                using element_type = typename P::element_type;
+                auto bytes = reinterpret_cast<unsigned char*>(p.get());
+                auto rows = slice_rows(p, y, 0);
+                for(auto k = std::size_t{0}; k < z; ++k)
+                    for(auto r = std::size_t{0}; r < y; ++r)
+                        std::fill_n(reinterpret_cast<element_type*>(bytes + (k * rows + r) * p.pitch()), x, value);
+            }
+
             template <class D, class S>
             auto create_3D_parms(D& d, const S& s, std::size_t x, std::size_t y, std::size_t z,
                     std::size_t d_off_x, std::size_t d_off_y, std::size_t d_off_z,
@@ -63,15 +95,15 @@ namespace glados
                         constexpr auto s_size = sizeof(typename S::element_type);
 
                         auto d_pitch = d.pitch();
-                        if(D::mem_location == memory_location::host)
+                        if(D::mem_location == memory_location::host && !D::pitched_memory)
                             d_pitch = x * d_size;
 
                         auto s_pitch = s.pitch();
-                        if(S::mem_location == memory_location::host)
+                        if(S::mem_location == memory_location::host && !S::pitched_memory)
                             s_pitch = x * s_size;
 
-                        auto d_pitched = make_cudaPitchedPtr(d.get(), d_pitch, x, y);
-                        auto s_pitched = make_cudaPitchedPtr(s.get(), s_pitch, x, y);
+                        auto d_pitched = make_cudaPitchedPtr(d.get(), d_pitch, x, slice_rows(d, y, 0));
+                        auto s_pitched = make_cudaPitchedPtr(s.get(), s_pitch, x, slice_rows(s, y, 0));
 
                         auto d_pos_x = to_uchar_pos(d_off_x, d_elem_size);
                         auto d_pos_y = to_uchar_pos(d_off_y, d_elem_size);
@@ -120,11 +152,11 @@ namespace glados
                     constexpr auto size = sizeof(typename D::element_type);
 
                     auto d_pitch = d.pitch();
-                    if(D::mem_location == memory_location::host)
+                    if(D::mem_location == memory_location::host && !D::pitched_memory)
                         d_pitch = x * size;
 
                     auto s_pitch = s.pitch();
-                    if(S::mem_location == memory_location::host)
+                    if(S::mem_location == memory_location::host && !S::pitched_memory)
                         s_pitch = x * size;
 
                     auto err = cudaMemcpy2D(d.get(), d_pitch, s.get(), s_pitch, x * size, y, detail::memcpy_direction<D::mem_location, S::mem_location>::value);
@@ -163,7 +195,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    std::fill_n(p.get(), x, value);
+                    detail::fill_host(p, value, x, 1, 1, std::integral_constant<bool, P::pitched_memory>{});
                 }
 
                 template <class P>
@@ -182,7 +214,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    std::fill_n(p.get(), x * y, value);
+                    detail::fill_host(p, value, x, y, 1, std::integral_constant<bool, P::pitched_memory>{});
                 }
 
                 template <class P>
@@ -193,7 +225,7 @@ namespace glados
 
                     constexpr auto size = sizeof(typename P::element_type);
                     auto extent = make_cudaExtent(x * size, y, z);
-                    auto pitched_ptr = make_cudaPitchedPtr(p.get(), p.pitch(), x * size, y);
+                    auto pitched_ptr = make_cudaPitchedPtr(p.get(), p.pitch(), x * size, detail::slice_rows(p, y, 0));
 
                     auto err = cudaMemset3D(pitched_ptr, value, extent);
                     if(err != cudaSuccess)
@@ -204,7 +236,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y, std::size_t z) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    std::fill_n(p.get(), x * y * z, value);
+                    detail::fill_host(p, value, x, y, z, std::integral_constant<bool, P::pitched_memory>{});
                 }
         };
 
@@ -237,11 +269,11 @@ namespace glados
                     constexpr auto size = sizeof(typename D::element_type);
 
                     auto d_pitch = d.pitch();
-                    if(D::mem_location == memory_location::host)
+                    if(D::mem_location == memory_location::host && !D::pitched_memory)
                         d_pitch = x * size;
 
                     auto s_pitch = s.pitch();
-                    if(S::mem_location == memory_location::host)
+                    if(S::mem_location == memory_location::host && !S::pitched_memory)
                         s_pitch = x * size;
 
                     auto err = cudaMemcpy2DAsync(d.get(), d_pitch, s.get(), s_pitch, x * size, y, detail::memcpy_direction<D::mem_location, S::mem_location>::value, stream);
@@ -286,7 +318,7 @@ namespace glados
                 {
                     // in an ideal world we wouldn't spawn threads manually but use std::async instead.
                     // However, the world isn't ideal and std::async is completely useless when you want to launch "fire and forget" tasks.
-                    auto f = [&]() { std::fill_n(p.get(), x, value); };
+                    auto f = [&]() { detail::fill_host(p, value, x, 1, 1, std::integral_constant<bool, P::pitched_memory>{}); };
                     auto&& t = std::thread{f};
                     t.detach();
                 }
@@ -308,7 +340,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    auto f = [&]() { std::fill_n(p.get(), x * y, value); };
+                    auto f = [&]() { detail::fill_host(p, value, x, y, 1, std::integral_constant<bool, P::pitched_memory>{}); };
                     auto&& t = std::thread{f};
                     t.detach();
                 }
@@ -321,7 +353,7 @@ namespace glados
 
                     constexpr auto size = sizeof(typename P::element_type);
                     auto extent = make_cudaExtent(x * size, y, z);
-                    auto pitched_ptr = make_cudaPitchedPtr(p.get(), p.pitch(), x * size, y);
+                    auto pitched_ptr = make_cudaPitchedPtr(p.get(), p.pitch(), x * size, detail::slice_rows(p, y, 0));
 
                     auto err = cudaMemset3DAsync(pitched_ptr, value, extent, stream);
                     if(err != cudaSuccess)
@@ -332,7 +364,7 @@ namespace glados
                 auto fill(P& p, int value, std::size_t x, std::size_t y, std::size_t z) const
                 -> typename std::enable_if<P::mem_location == memory_location::host, void>::type
                 {
-                    auto f = [&](){ std::fill_n(p.get(), x * y * z, value); };
+                    auto f = [&](){ detail::fill_host(p, value, x, y, z, std::integral_constant<bool, P::pitched_memory>{}); };
                     auto&& t = std::thread{f};
                     t.detach();
                 }
@@ -26,7 +26,11 @@
 #include <algorithm>
 #include <memory>
 #include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
 
+#include <glados/bits/array_size.h>
 #include <glados/bits/memory_layout.h>
 #include <glados/bits/memory_location.h>
 
@@ -34,6 +38,75 @@ namespace glados
 {
     namespace generic
     {
+        /*
+         * Alignment of the memory generic::allocator returns for trivial types,
+         * one cache line (and AVX-512 vector) by default. Specialize it to
+         * change the alignment for a type; the value has to be a power of two
+         * and a multiple of sizeof(void*).
+         */
+        template <class T>
+        struct allocation_alignment : std::integral_constant<std::size_t, (alignof(T) > 64) ? alignof(T) : 64> {};
+
+        namespace detail
+        {
+            /* elements of such types need neither construction nor destruction */
+            template <class T>
+            using allocates_uninitialized = std::integral_constant<bool, std::is_trivially_default_constructible<T>::value
+                                                                         && std::is_trivially_destructible<T>::value>;
+
+            template <class T>
+            auto allocate_n(std::size_t n, std::true_type) -> T*
+            {
+                auto p = static_cast<void*>(nullptr);
+                auto bytes = glados::detail::array_size(n, sizeof(T));
+                if(::posix_memalign(&p, allocation_alignment<T>::value, std::max(bytes, std::size_t{1})) != 0)
+                    throw std::bad_alloc{};
+                return static_cast<T*>(p);
+            }
+
+            template <class T>
+            auto allocate_n(std::size_t n, std::false_type) -> T*
+            {
+                return new T[n];
+            }
+
+            template <class T>
+            auto deallocate_n(T* p, std::true_type) noexcept -> void
+            {
+                std::free(p);
+            }
+
+            template <class T>
+            auto deallocate_n(T* p, std::false_type) noexcept -> void
+            {
+                delete[] p;
+            }
+        }
+
+        /*
+         * Releases memory from generic::allocator<T>, e.g. as the deleter of a
+         * std::unique_ptr<T[]>.
+         */
+        template <class T>
+        struct deleter
+        {
+            auto operator()(T* p) const noexcept -> void
+            {
+                detail::deallocate_n(p, detail::allocates_uninitialized<T>{});
+            }
+        };
+
+        /*
+         * Memory for trivial types is aligned to allocation_alignment<T> and left
+         * uninitialized, so it is not touched before its first real use. Other
+         * types are allocated with new T[].
+         *
+         * Unlike in earlier versions, memory for trivial types comes from
+         * posix_memalign() and must not be passed to delete[] or
+         * std::default_delete<T[]>; release it with deallocate() or
+         * generic::deleter<T>. Extents whose product overflows throw
+         * std::bad_array_new_length.
+         */
         template <class T, memory_layout ml>
         class allocator {};
 
@@ -44,6 +117,8 @@ namespace glados
                 static constexpr auto mem_layout = memory_layout::pointer_1D;
                 static constexpr auto mem_location = memory_location::host;
                 static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+                static constexpr auto alignment = detail::allocates_uninitialized<T>::value ? allocation_alignment<T>::value : alignof(T);
 
                 using value_type = T;
                 using pointer = value_type*;
@@ -77,12 +152,12 @@ namespace glados
 
                 auto allocate(size_type n) -> pointer
                 {
-                    return new T[n];
+                    return detail::allocate_n<T>(n, detail::allocates_uninitialized<T>{});
                 }
 
                 auto deallocate(pointer p, size_type = 0) noexcept -> void
                 {
-                    delete[] p;
+                    detail::deallocate_n(p, detail::allocates_uninitialized<T>{});
                 }
         };
 
@@ -93,6 +168,8 @@ namespace glados
                 static constexpr auto mem_layout = memory_layout::pointer_2D;
                 static constexpr auto mem_location = memory_location::host;
                 static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+                static constexpr auto alignment = detail::allocates_uninitialized<T>::value ? allocation_alignment<T>::value : alignof(T);
 
                 using value_type = T;
                 using pointer = value_type*;
@@ -126,12 +203,12 @@ namespace glados
 
                 auto allocate(size_type x, size_type y) -> pointer
                 {
-                    return new T[x * y];
+                    return detail::allocate_n<T>(glados::detail::array_size(x, y), detail::allocates_uninitialized<T>{});
                 }
 
                 auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
                 {
-                    delete[] p;
+                    detail::deallocate_n(p, detail::allocates_uninitialized<T>{});
                 }
         };
 
@@ -142,6 +219,8 @@ namespace glados
                 static constexpr auto mem_layout = memory_layout::pointer_3D;
                 static constexpr auto mem_location = memory_location::host;
                 static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+                static constexpr auto alignment = detail::allocates_uninitialized<T>::value ? allocation_alignment<T>::value : alignof(T);
 
                 using value_type = T;
                 using pointer = value_type*;
@@ -175,12 +254,12 @@ namespace glados
 
                 auto allocate(size_type x, size_type y, size_type z) -> pointer
                 {
-                    return new T[x * y * z];
+                    return detail::allocate_n<T>(glados::detail::array_size(x, y, z), detail::allocates_uninitialized<T>{});
                 }
 
                 auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
                 {
-                    delete[] p;
+                    detail::deallocate_n(p, detail::allocates_uninitialized<T>{});
                 }
         };
     }
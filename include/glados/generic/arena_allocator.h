@@ -0,0 +1,427 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_GENERIC_ARENA_ALLOCATOR_H_
+#define GLADOS_GENERIC_ARENA_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glados/bits/array_size.h>
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * Bump allocator for short-lived scratch memory. Chunks are cut from
+         * large blocks and are never freed individually; reset() rewinds the
+         * arena and keeps the blocks for the next round, release() returns them.
+         * Requests larger than the block size get a block of their own.
+         *
+         * An arena is not thread-safe, it is meant to be used by one task at a
+         * time. thread_arena() provides one arena per thread.
+         */
+        class arena
+        {
+            public:
+                static constexpr auto default_block_size = std::size_t{4} << 20;
+                static constexpr auto default_alignment = std::size_t{64};
+
+            public:
+                explicit arena(std::size_t block_size = default_block_size, std::size_t alignment = default_alignment)
+                : block_size_{block_size}, alignment_{std::max(alignment, alignof(std::max_align_t))}
+                , current_{0}, offset_{0}, used_{0}
+                {}
+
+                arena(arena&&) noexcept = default;
+                auto operator=(arena&&) noexcept -> arena& = default;
+
+                arena(const arena&) = delete;
+                auto operator=(const arena&) -> arena& = delete;
+
+                auto allocate(std::size_t bytes) -> void*
+                {
+                    if(bytes == 0)
+                        bytes = 1;
+
+                    // checked up front, so an impossible request leaves the arena untouched
+                    auto padded = glados::detail::padded_size(bytes, alignment_);
+
+                    while(current_ < blocks_.size())
+                    {
+                        auto& b = blocks_[current_];
+                        auto start = align(b.data.get(), offset_);
+                        if(start <= b.size && bytes <= b.size - start)
+                        {
+                            offset_ = start + bytes;
+                            used_ += bytes;
+                            return b.data.get() + start;
+                        }
+
+                        // the rest of this block is lost until reset()
+                        ++current_;
+                        offset_ = 0;
+                    }
+
+                    auto size = std::max(block_size_, padded);
+                    blocks_.push_back(block{std::unique_ptr<unsigned char[]>{new unsigned char[size]}, size});
+                    current_ = blocks_.size() - 1;
+
+                    auto& b = blocks_.back();
+                    auto start = align(b.data.get(), 0);
+                    offset_ = start + bytes;
+                    used_ += bytes;
+                    return b.data.get() + start;
+                }
+
+                /* invalidates every chunk handed out so far, the blocks are kept */
+                auto reset() noexcept -> void
+                {
+                    // dedicated blocks for oversized requests would otherwise pile up
+                    blocks_.erase(std::remove_if(std::begin(blocks_), std::end(blocks_),
+                                                 [this](const block& b) { return b.size > block_size_; }),
+                                  std::end(blocks_));
+                    current_ = 0;
+                    offset_ = 0;
+                    used_ = 0;
+                }
+
+                /* like reset(), but returns the blocks as well */
+                auto release() noexcept -> void
+                {
+                    blocks_.clear();
+                    current_ = 0;
+                    offset_ = 0;
+                    used_ = 0;
+                }
+
+                /* bytes handed out since the last reset() */
+                auto used() const noexcept -> std::size_t
+                {
+                    return used_;
+                }
+
+                auto capacity() const noexcept -> std::size_t
+                {
+                    auto c = std::size_t{0};
+                    for(auto&& b : blocks_)
+                        c += b.size;
+                    return c;
+                }
+
+                auto alignment() const noexcept -> std::size_t
+                {
+                    return alignment_;
+                }
+
+            private:
+                struct block
+                {
+                    std::unique_ptr<unsigned char[]> data;
+                    std::size_t size;
+                };
+
+                auto align(const unsigned char* base, std::size_t offset) const noexcept -> std::size_t
+                {
+                    auto addr = reinterpret_cast<std::uintptr_t>(base) + offset;
+                    auto aligned = (addr + alignment_ - 1) / alignment_ * alignment_;
+                    return offset + (aligned - addr);
+                }
+
+            private:
+                std::size_t block_size_;
+                std::size_t alignment_;
+                std::vector<block> blocks_;
+                std::size_t current_;
+                std::size_t offset_;
+                std::size_t used_;
+        };
+
+        /* the calling thread's arena, used by default-constructed arena_allocators */
+        inline auto thread_arena() -> arena&
+        {
+            thread_local auto a = arena{};
+            return a;
+        }
+
+        /* resets an arena when leaving a scope, e.g. at the end of a task */
+        class arena_scope
+        {
+            public:
+                explicit arena_scope(arena& a = thread_arena()) noexcept
+                : arena_{a}
+                {}
+
+                ~arena_scope()
+                {
+                    arena_.reset();
+                }
+
+                arena_scope(const arena_scope&) = delete;
+                auto operator=(const arena_scope&) -> arena_scope& = delete;
+
+            private:
+                arena& arena_;
+        };
+
+        namespace detail
+        {
+            template <class T>
+            auto arena_construct(arena& a, std::size_t n) -> T*
+            {
+                static_assert(std::is_trivially_destructible<T>::value, "arena memory is released without running destructors");
+                auto p = static_cast<T*>(a.allocate(glados::detail::array_size(n, sizeof(T))));
+                if(!std::is_trivially_default_constructible<T>::value)
+                {
+                    for(auto i = std::size_t{0}; i < n; ++i)
+                        ::new(static_cast<void*>(p + i)) T;
+                }
+                return p;
+            }
+        }
+
+        /*
+         * Allocator interface on top of an arena, with the 1D/2D/3D signatures of
+         * generic::allocator. deallocate() does nothing; the memory is reclaimed
+         * by arena::reset(). A default-constructed arena_allocator uses the
+         * thread_arena() of the thread calling allocate(), so it can be created on
+         * one thread and used on others. Elements are default-initialized like
+         * with new T[n]; sizes which do not fit into std::size_t throw
+         * std::bad_array_new_length.
+         */
+        template <class T, memory_layout ml>
+        class arena_allocator {};
+
+        template <class T>
+        class arena_allocator<T, memory_layout::pointer_1D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_1D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = arena_allocator<U, mem_layout>;
+                };
+
+                arena_allocator() noexcept
+                : arena_{nullptr}
+                {}
+
+                explicit arena_allocator(arena& a) noexcept
+                : arena_{&a}
+                {}
+
+                arena_allocator(const arena_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                arena_allocator(const arena_allocator<U, uml>& other) noexcept
+                : arena_{other.arena_}
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~arena_allocator() = default;
+
+                auto allocate(size_type n) -> pointer
+                {
+                    return detail::arena_construct<T>(*get_arena(), n);
+                }
+
+                auto deallocate(pointer, size_type = 0) noexcept -> void
+                {}
+
+                /* the arena allocate() uses when called from this thread */
+                auto get_arena() const -> arena*
+                {
+                    return (arena_ != nullptr) ? arena_ : &thread_arena();
+                }
+
+            private:
+                template <class U, memory_layout uml>
+                friend class arena_allocator;
+
+                arena* arena_; // nullptr: the calling thread's thread_arena()
+        };
+
+        template <class T>
+        class arena_allocator<T, memory_layout::pointer_2D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = arena_allocator<U, mem_layout>;
+                };
+
+                arena_allocator() noexcept
+                : arena_{nullptr}
+                {}
+
+                explicit arena_allocator(arena& a) noexcept
+                : arena_{&a}
+                {}
+
+                arena_allocator(const arena_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                arena_allocator(const arena_allocator<U, uml>& other) noexcept
+                : arena_{other.arena_}
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~arena_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    return detail::arena_construct<T>(*get_arena(), glados::detail::array_size(x, y));
+                }
+
+                auto deallocate(pointer, size_type = 0, size_type = 0) noexcept -> void
+                {}
+
+                /* the arena allocate() uses when called from this thread */
+                auto get_arena() const -> arena*
+                {
+                    return (arena_ != nullptr) ? arena_ : &thread_arena();
+                }
+
+            private:
+                template <class U, memory_layout uml>
+                friend class arena_allocator;
+
+                arena* arena_; // nullptr: the calling thread's thread_arena()
+        };
+
+        template <class T>
+        class arena_allocator<T, memory_layout::pointer_3D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = arena_allocator<U, mem_layout>;
+                };
+
+                arena_allocator() noexcept
+                : arena_{nullptr}
+                {}
+
+                explicit arena_allocator(arena& a) noexcept
+                : arena_{&a}
+                {}
+
+                arena_allocator(const arena_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                arena_allocator(const arena_allocator<U, uml>& other) noexcept
+                : arena_{other.arena_}
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~arena_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    return detail::arena_construct<T>(*get_arena(), glados::detail::array_size(x, y, z));
+                }
+
+                auto deallocate(pointer, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {}
+
+                /* the arena allocate() uses when called from this thread */
+                auto get_arena() const -> arena*
+                {
+                    return (arena_ != nullptr) ? arena_ : &thread_arena();
+                }
+
+            private:
+                template <class U, memory_layout uml>
+                friend class arena_allocator;
+
+                arena* arena_; // nullptr: the calling thread's thread_arena()
+        };
+    }
+}
+
+#endif /* GLADOS_GENERIC_ARENA_ALLOCATOR_H_ */
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_GENERIC_BRICKED_ALLOCATOR_H_
+#define GLADOS_GENERIC_BRICKED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include <glados/bits/bricked_layout.h>
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+#include <glados/generic/allocator.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        /*
+         * Host allocator for 3D volumes stored brick by brick. Neighbouring voxels
+         * in all three directions end up in the same few cache lines, which helps
+         * stencils and slicing along y and z. allocate() pads the volume to whole
+         * bricks; use view() or bricked_layout to address the elements and
+         * copy_to_bricked() / copy_to_linear() to convert from and to pointer_3D.
+         */
+        template <class T, std::size_t Brick = 8, brick_order Order = brick_order::linear>
+        class bricked_allocator
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::bricked_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+                static constexpr auto alignment = detail::allocates_uninitialized<T>::value ? allocation_alignment<T>::value : alignof(T);
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                using layout_type = bricked_layout<Brick, Order>;
+                using view_type = bricked_view<T, Brick, Order>;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = bricked_allocator<U, Brick, Order>;
+                };
+
+                bricked_allocator() noexcept = default;
+                bricked_allocator(const bricked_allocator& other) noexcept = default;
+
+                template <class U, std::size_t UBrick, brick_order UOrder>
+                bricked_allocator(const bricked_allocator<U, UBrick, UOrder>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && Brick == UBrick && Order == UOrder, "Attempting to copy incompatible allocator");
+                }
+
+                ~bricked_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    auto l = layout_type{x, y, z};
+                    auto n = glados::detail::array_size(l.bricks_x(), l.bricks_y(), l.bricks_z(), layout_type::brick_volume);
+                    return detail::allocate_n<T>(n, detail::allocates_uninitialized<T>{});
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    detail::deallocate_n(p, detail::allocates_uninitialized<T>{});
+                }
+
+                static auto view(pointer p, size_type x, size_type y, size_type z) noexcept -> view_type
+                {
+                    return view_type{p, x, y, z};
+                }
+        };
+
+    }
+}
+
+#endif /* GLADOS_GENERIC_BRICKED_ALLOCATOR_H_ */
@@ -0,0 +1,462 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_GENERIC_FILE_ALLOCATOR_H_
+#define GLADOS_GENERIC_FILE_ALLOCATOR_H_
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <glados/bits/array_size.h>
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        enum class access_pattern
+        {
+            normal,
+            sequential, // aggressive read-ahead, pages behind are dropped early
+            random,     // no read-ahead
+            will_need   // start reading the whole window right away
+        };
+
+        struct mapping_options
+        {
+            access_pattern advice = access_pattern::sequential;
+            bool populate = false;  // fault in every page at map time
+            bool shared = false;    // writable, writes go to the file
+            bool writable = false;  // private windows can be written, written pages become private copies
+        };
+
+        /*
+         * A raw data file whose contents are mapped into memory window by window,
+         * directly from the page cache. Windows are handed out in file order by
+         * map_next() (see file_allocator) or at explicit offsets by map(); each
+         * stays valid until it is unmapped or the mapped_file is destroyed.
+         *
+         * map(), map_next() and unmap() are thread-safe.
+         */
+        class mapped_file
+        {
+            public:
+                explicit mapped_file(const std::string& path, mapping_options options = mapping_options{})
+                : fd_{-1}, size_{0}, options_(options), next_{0}
+                {
+                    fd_ = ::open(path.c_str(), (options_.shared ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+                    if(fd_ == -1)
+                        throw std::system_error{errno, std::system_category(), "glados::generic::mapped_file: open failed"};
+
+                    struct stat st;
+                    if(::fstat(fd_, &st) == -1)
+                    {
+                        auto err = errno;
+                        ::close(fd_);
+                        throw std::system_error{err, std::system_category(), "glados::generic::mapped_file: fstat failed"};
+                    }
+                    size_ = static_cast<std::size_t>(st.st_size);
+                }
+
+                mapped_file(const mapped_file&) = delete;
+                auto operator=(const mapped_file&) -> mapped_file& = delete;
+
+                ~mapped_file()
+                {
+                    for(auto&& m : mappings_)
+                        ::munmap(m.second.first, m.second.second);
+                    if(fd_ != -1)
+                        ::close(fd_);
+                }
+
+                auto size() const noexcept -> std::size_t
+                {
+                    return size_;
+                }
+
+                auto options() const noexcept -> const mapping_options&
+                {
+                    return options_;
+                }
+
+                /* maps bytes bytes starting at offset */
+                auto map(std::size_t offset, std::size_t bytes) -> void*
+                {
+                    // written without offset + bytes, which could wrap around
+                    if(bytes == 0 || offset > size_ || bytes > size_ - offset)
+                        throw std::out_of_range{"glados::generic::mapped_file: window exceeds the file"};
+
+                    // mmap offsets have to be page-aligned
+                    static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                    auto aligned = offset / page * page;
+                    auto length = bytes + (offset - aligned);
+
+                    // read-only unless asked otherwise, so the window stays in the page cache
+                    auto writable = options_.shared || options_.writable;
+                    auto prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+                    auto flags = options_.shared ? MAP_SHARED : MAP_PRIVATE;
+
+                    // MAP_POPULATE write-faults private writable mappings, i.e. copies every page
+                    auto copy_on_write = writable && !options_.shared;
+#ifdef MAP_POPULATE
+                    if(options_.populate && !copy_on_write)
+                        flags |= MAP_POPULATE;
+#endif
+
+                    auto base = ::mmap(nullptr, length, prot, flags, fd_, static_cast<off_t>(aligned));
+                    if(base == MAP_FAILED)
+                        throw std::system_error{errno, std::system_category(), "glados::generic::mapped_file: mmap failed"};
+
+                    advise(base, length);
+                    if(options_.populate && copy_on_write)
+                        populate_read(base, length);
+
+                    auto p = static_cast<void*>(static_cast<unsigned char*>(base) + (offset - aligned));
+                    try
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        mappings_.emplace(p, std::make_pair(base, length));
+                    }
+                    catch(...)
+                    {
+                        ::munmap(base, length);
+                        throw;
+                    }
+                    return p;
+                }
+
+                /* maps the next bytes bytes after the previous map_next() window */
+                auto map_next(std::size_t bytes) -> void*
+                {
+                    // only advance next_ if the window fits, so concurrent callers never see a bogus end of file
+                    auto offset = next_.load();
+                    do
+                    {
+                        if(bytes == 0 || offset > size_ || bytes > size_ - offset)
+                            throw std::out_of_range{"glados::generic::mapped_file: end of file reached"};
+                    }
+                    while(!next_.compare_exchange_weak(offset, offset + bytes));
+
+                    return map(offset, bytes);
+                }
+
+                /* where the next map_next() window starts */
+                auto seek(std::size_t offset) noexcept -> void
+                {
+                    next_.store(offset);
+                }
+
+                auto tell() const noexcept -> std::size_t
+                {
+                    return next_.load();
+                }
+
+                auto unmap(const void* p) noexcept -> void
+                {
+                    if(p == nullptr)
+                        return;
+
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    auto it = mappings_.find(p);
+                    if(it == std::end(mappings_))
+                        return;
+
+                    ::munmap(it->second.first, it->second.second);
+                    mappings_.erase(it);
+                }
+
+            private:
+                /* faults the pages in for reading only */
+                static auto populate_read(void* base, std::size_t length) noexcept -> void
+                {
+#ifdef MADV_POPULATE_READ
+                    if(::madvise(base, length, MADV_POPULATE_READ) == 0)
+                        return;
+#endif
+                    // older kernels: at least start reading
+                    ::madvise(base, length, MADV_WILLNEED);
+                }
+
+                auto advise(void* base, std::size_t length) noexcept -> void
+                {
+                    switch(options_.advice)
+                    {
+                        case access_pattern::sequential:
+                            ::madvise(base, length, MADV_SEQUENTIAL);
+                            break;
+
+                        case access_pattern::random:
+                            ::madvise(base, length, MADV_RANDOM);
+                            break;
+
+                        case access_pattern::will_need:
+                            ::madvise(base, length, MADV_WILLNEED);
+                            break;
+
+                        default:
+                            break;
+                    }
+                }
+
+            private:
+                int fd_;
+                std::size_t size_;
+                mapping_options options_;
+                std::atomic<std::size_t> next_;
+                std::mutex mutex_;
+                std::map<const void*, std::pair<void*, std::size_t>> mappings_;
+        };
+
+        /* unmaps a window when used as the deleter of a smart pointer */
+        class mapped_deleter
+        {
+            public:
+                mapped_deleter() noexcept : file_{nullptr} {}
+                explicit mapped_deleter(mapped_file* file) noexcept : file_{file} {}
+
+                auto operator()(const void* p) const noexcept -> void
+                {
+                    if(file_ != nullptr)
+                        file_->unmap(p);
+                }
+
+            private:
+                mapped_file* file_;
+        };
+
+        /*
+         * Allocator interface on top of a mapped_file: every allocate() call maps
+         * the next window of the file with the dense 1D/2D/3D layout of
+         * generic::allocator, so a stage can walk through a raw projection stack
+         * without copying it. deallocate() unmaps the window.
+         */
+        template <class T, memory_layout ml>
+        class file_allocator {};
+
+        template <class T>
+        class file_allocator<T, memory_layout::pointer_1D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_1D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = file_allocator<U, mem_layout>;
+                };
+
+                static_assert(std::is_trivially_copyable<T>::value, "file contents can only be viewed as trivially copyable types");
+
+                explicit file_allocator(mapped_file& file) noexcept
+                : file_{&file}
+                {}
+
+                file_allocator(const file_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                file_allocator(const file_allocator<U, uml>& other) noexcept
+                : file_{other.file()}
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~file_allocator() = default;
+
+                auto allocate(size_type n) -> pointer
+                {
+                    return static_cast<pointer>(file_->map_next(glados::detail::array_size(n, sizeof(T))));
+                }
+
+                auto deallocate(pointer p, size_type = 0) noexcept -> void
+                {
+                    file_->unmap(p);
+                }
+
+                auto file() const noexcept -> mapped_file*
+                {
+                    return file_;
+                }
+
+            private:
+                mapped_file* file_;
+        };
+
+        template <class T>
+        class file_allocator<T, memory_layout::pointer_2D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = file_allocator<U, mem_layout>;
+                };
+
+                static_assert(std::is_trivially_copyable<T>::value, "file contents can only be viewed as trivially copyable types");
+
+                explicit file_allocator(mapped_file& file) noexcept
+                : file_{&file}
+                {}
+
+                file_allocator(const file_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                file_allocator(const file_allocator<U, uml>& other) noexcept
+                : file_{other.file()}
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~file_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    return static_cast<pointer>(file_->map_next(glados::detail::array_size(x, y, sizeof(T))));
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    file_->unmap(p);
+                }
+
+                auto file() const noexcept -> mapped_file*
+                {
+                    return file_;
+                }
+
+            private:
+                mapped_file* file_;
+        };
+
+        template <class T>
+        class file_allocator<T, memory_layout::pointer_3D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::false_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = file_allocator<U, mem_layout>;
+                };
+
+                static_assert(std::is_trivially_copyable<T>::value, "file contents can only be viewed as trivially copyable types");
+
+                explicit file_allocator(mapped_file& file) noexcept
+                : file_{&file}
+                {}
+
+                file_allocator(const file_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                file_allocator(const file_allocator<U, uml>& other) noexcept
+                : file_{other.file()}
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~file_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    return static_cast<pointer>(file_->map_next(glados::detail::array_size(x, y, z, sizeof(T))));
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    file_->unmap(p);
+                }
+
+                auto file() const noexcept -> mapped_file*
+                {
+                    return file_;
+                }
+
+            private:
+                mapped_file* file_;
+        };
+    }
+}
+
+#endif /* GLADOS_GENERIC_FILE_ALLOCATOR_H_ */
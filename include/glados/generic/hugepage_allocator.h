@@ -0,0 +1,384 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#ifndef GLADOS_GENERIC_HUGEPAGE_ALLOCATOR_H_
+#define GLADOS_GENERIC_HUGEPAGE_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+
+#include <sys/mman.h>
+
+#include <glados/bits/array_size.h>
+#include <glados/bits/memory_layout.h>
+#include <glados/bits/memory_location.h>
+
+namespace glados
+{
+    namespace generic
+    {
+        enum class page_backing
+        {
+            hugetlb,        // explicit huge pages from the hugetlbfs pool
+            transparent,    // huge page aligned, transparent huge pages requested via madvise
+            small           // regular pages, either too small to bother or no huge page support
+        };
+
+        namespace detail
+        {
+            constexpr auto huge_page_size = std::size_t{2} << 20;
+
+            struct huge_mapping
+            {
+                std::size_t bytes;
+                page_backing backing;
+            };
+
+            /*
+             * Size and backing of every live allocation, keyed by its address. Kept
+             * out of band so that a mapping is exactly round_up(bytes, huge_page_size)
+             * and the data starts on a huge page boundary.
+             */
+            class huge_registry
+            {
+                private:
+                    using lock_type = std::lock_guard<std::mutex>;
+
+                public:
+                    auto add(const void* p, huge_mapping m) -> void
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        mappings_.emplace(p, m);
+                    }
+
+                    auto remove(const void* p) noexcept -> huge_mapping
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        auto it = mappings_.find(p);
+                        if(it == std::end(mappings_))
+                            return huge_mapping{0, page_backing::small};
+
+                        auto m = it->second;
+                        mappings_.erase(it);
+                        return m;
+                    }
+
+                    auto find(const void* p) const noexcept -> huge_mapping
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        auto it = mappings_.find(p);
+                        return (it == std::end(mappings_)) ? huge_mapping{0, page_backing::small} : it->second;
+                    }
+
+                private:
+                    mutable std::mutex mutex_;
+                    std::unordered_map<const void*, huge_mapping> mappings_;
+            };
+
+            /* never destroyed, static pools may still release memory during exit */
+            inline auto huge_mappings() -> huge_registry&
+            {
+                static auto registry = new huge_registry{};
+                return *registry;
+            }
+
+            inline auto round_up(std::size_t n, std::size_t to) noexcept -> std::size_t
+            {
+                return (n + to - 1) / to * to;
+            }
+
+            inline auto release_mapping(void* p, const huge_mapping& m) noexcept -> void
+            {
+                // everything below a huge page came from posix_memalign
+                if(m.bytes < huge_page_size)
+                    std::free(p);
+                else
+                    ::munmap(p, m.bytes);
+            }
+
+            inline auto register_mapping(void* p, std::size_t bytes, page_backing backing) -> void*
+            {
+                auto m = huge_mapping{bytes, backing};
+                try
+                {
+                    huge_mappings().add(p, m);
+                }
+                catch(...)
+                {
+                    release_mapping(p, m);
+                    throw;
+                }
+                return p;
+            }
+
+            /*
+             * Tries MAP_HUGETLB first, then an anonymous mapping aligned to a huge
+             * page and marked with MADV_HUGEPAGE. Allocations smaller than a huge
+             * page come from posix_memalign. Throws std::bad_alloc if every attempt
+             * fails.
+             */
+            inline auto huge_allocate(std::size_t bytes) -> void*
+            {
+                if(bytes < huge_page_size)
+                {
+                    auto p = static_cast<void*>(nullptr);
+                    if(::posix_memalign(&p, 64, std::max(bytes, std::size_t{1})) != 0)
+                        throw std::bad_alloc{};
+                    return register_mapping(p, bytes, page_backing::small);
+                }
+
+                // round_up() would wrap around for sizes close to SIZE_MAX
+                glados::detail::padded_size(bytes, huge_page_size - 1);
+                auto size = round_up(bytes, huge_page_size);
+#ifdef MAP_HUGETLB
+                auto base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if(base != MAP_FAILED)
+                    return register_mapping(base, size, page_backing::hugetlb);
+#endif
+
+                // over-allocate so that the mapping can be trimmed to huge page alignment
+                auto raw = ::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if(raw == MAP_FAILED)
+                    throw std::bad_alloc{};
+
+                auto raw_addr = reinterpret_cast<std::uintptr_t>(raw);
+                auto aligned = round_up(raw_addr, huge_page_size);
+                if(aligned != raw_addr)
+                    ::munmap(raw, aligned - raw_addr);
+                auto tail = (raw_addr + size + huge_page_size) - (aligned + size);
+                if(tail != 0)
+                    ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+
+                base = reinterpret_cast<void*>(aligned);
+                auto backing = page_backing::small;
+#ifdef MADV_HUGEPAGE
+                if(::madvise(base, size, MADV_HUGEPAGE) == 0)
+                    backing = page_backing::transparent;
+#endif
+                return register_mapping(base, size, backing);
+            }
+
+            inline auto huge_deallocate(void* p) noexcept -> void
+            {
+                if(p == nullptr)
+                    return;
+
+                release_mapping(p, huge_mappings().remove(p));
+            }
+
+            /* bytes actually mapped for p */
+            inline auto mapped_bytes(const void* p) noexcept -> std::size_t
+            {
+                return huge_mappings().find(p).bytes;
+            }
+        }
+
+        /* how the memory behind a pointer returned by hugepage_allocator is backed */
+        template <class T>
+        auto backing_of(const T* p) noexcept -> page_backing
+        {
+            return detail::huge_mappings().find(p).backing;
+        }
+
+        /*
+         * Host allocator for large buffers backed by huge pages, which keeps the
+         * TLB miss rate of strided 3D access low. The memory is mapped with
+         * MAP_HUGETLB if the system has reserved huge pages, otherwise aligned
+         * to 2 MiB and handed to the transparent huge page mechanism. Small
+         * requests and systems without huge page support get regular pages.
+         *
+         * Elements are not initialized (fresh mappings are zeroed by the
+         * kernel), so T has to be trivial. The layouts are dense like
+         * generic::allocator's; the allocators can be used as the InternalAlloc
+         * of pool_allocator.
+         */
+        template <class T, memory_layout ml>
+        class hugepage_allocator {};
+
+        template <class T>
+        class hugepage_allocator<T, memory_layout::pointer_1D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_1D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = hugepage_allocator<U, mem_layout>;
+                };
+
+                static_assert(std::is_trivial<T>::value, "hugepage_allocator does not construct its elements");
+
+                hugepage_allocator() noexcept = default;
+                hugepage_allocator(const hugepage_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                hugepage_allocator(const hugepage_allocator<U, uml>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~hugepage_allocator() = default;
+
+                auto allocate(size_type n) -> pointer
+                {
+                    return static_cast<pointer>(detail::huge_allocate(glados::detail::array_size(n, sizeof(T))));
+                }
+
+                auto deallocate(pointer p, size_type = 0) noexcept -> void
+                {
+                    detail::huge_deallocate(p);
+                }
+        };
+
+        template <class T>
+        class hugepage_allocator<T, memory_layout::pointer_2D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_2D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = hugepage_allocator<U, mem_layout>;
+                };
+
+                static_assert(std::is_trivial<T>::value, "hugepage_allocator does not construct its elements");
+
+                hugepage_allocator() noexcept = default;
+                hugepage_allocator(const hugepage_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                hugepage_allocator(const hugepage_allocator<U, uml>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~hugepage_allocator() = default;
+
+                auto allocate(size_type x, size_type y) -> pointer
+                {
+                    return static_cast<pointer>(detail::huge_allocate(glados::detail::array_size(x, y, sizeof(T))));
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    detail::huge_deallocate(p);
+                }
+        };
+
+        template <class T>
+        class hugepage_allocator<T, memory_layout::pointer_3D>
+        {
+            public:
+                static constexpr auto mem_layout = memory_layout::pointer_3D;
+                static constexpr auto mem_location = memory_location::host;
+                static constexpr auto alloc_needs_pitch = false;
+                static constexpr auto anonymous_memory = true;
+
+                using value_type = T;
+                using pointer = value_type*;
+                using const_pointer = const pointer;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+                using propagate_on_container_copy_assignment = std::true_type;
+                using propagate_on_container_move_assignment = std::true_type;
+                using propagate_on_container_swap = std::true_type;
+                using is_always_equal = std::true_type;
+
+                template <class Deleter>
+                using smart_pointer = std::unique_ptr<T[], Deleter>;
+
+                template <class U>
+                struct rebind
+                {
+                    using other = hugepage_allocator<U, mem_layout>;
+                };
+
+                static_assert(std::is_trivial<T>::value, "hugepage_allocator does not construct its elements");
+
+                hugepage_allocator() noexcept = default;
+                hugepage_allocator(const hugepage_allocator& other) noexcept = default;
+
+                template <class U, memory_layout uml>
+                hugepage_allocator(const hugepage_allocator<U, uml>&) noexcept
+                {
+                    static_assert(std::is_same<T, U>::value && mem_layout == uml, "Attempting to copy incompatible allocator");
+                }
+
+                ~hugepage_allocator() = default;
+
+                auto allocate(size_type x, size_type y, size_type z) -> pointer
+                {
+                    return static_cast<pointer>(detail::huge_allocate(glados::detail::array_size(x, y, z, sizeof(T))));
+                }
+
+                auto deallocate(pointer p, size_type = 0, size_type = 0, size_type = 0) noexcept -> void
+                {
+                    detail::huge_deallocate(p);
+                }
+        };
+    }
+}
+
+#endif /* GLADOS_GENERIC_HUGEPAGE_ALLOCATOR_H_ */
@@ -23,8 +23,11 @@
 #ifndef GLADOS_MEMORY_H_
 #define GLADOS_MEMORY_H_
 
+#include <glados/bits/memory_budget.h>
 #include <glados/bits/memory_layout.h>
 #include <glados/bits/memory_location.h>
 #include <glados/bits/pool_allocator.h>
+#include <glados/bits/size_class_pool_allocator.h>
+#include <glados/bits/strided_view.h>
 
 #endif /* GLADOS_MEMORY_H_ */
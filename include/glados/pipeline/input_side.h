@@ -24,12 +24,17 @@
 #define GLADOS_PIPELINE_INPUT_SIDE_H_
 
 #include <cstddef>
+#include <functional>
 #include <mutex>
 #include <queue>
+#include <stdexcept>
 #include <thread>
 #include <type_traits>
 #include <utility>
 
+#include <glados/bits/memory_budget.h>
+#include <glados/pipeline/trace.h>
+
 namespace glados
 {
     namespace pipeline
@@ -57,6 +62,11 @@ namespace glados
                     auto&& lock = write_lock{other.mutex_};
                     queue_ = std::move(other.queue_);
                     limit_ = std::move(other.limit_);
+                    traces_ = std::move(other.traces_);
+                    hop_ = other.hop_;
+                    budget_ = other.budget_;
+                    bytes_of_ = std::move(other.bytes_of_);
+                    charges_ = std::move(other.charges_);
                 }
 
                 auto operator=(input_side&& other) -> input_side&
@@ -69,6 +79,11 @@ namespace glados
                         std::lock(this_lock, other_lock);
                         queue_ = std::move(other.queue_);
                         limit_ = std::move(other.limit_);
+                        traces_ = std::move(other.traces_);
+                        hop_ = other.hop_;
+                        budget_ = other.budget_;
+                        bytes_of_ = std::move(other.bytes_of_);
+                        charges_ = std::move(other.charges_);
                     }
 
                     return *this;
@@ -83,8 +98,28 @@ namespace glados
                             std::this_thread::yield();
                     }
 
+                    auto bytes = std::size_t{0};
+                    if(budget_ != nullptr)
+                    {
+                        bytes = bytes_of_(t);
+                        budget_->acquire(bytes);
+                    }
+
+                    if(hop_ != nullptr)
+                    {
+                        auto ctx = detail::trace_input(hop_);
+                        auto&& lock = write_lock{mutex_};
+                        queue_.push(std::forward<T>(t));
+                        traces_.push(ctx);
+                        if(budget_ != nullptr)
+                            charges_.push(bytes);
+                        return;
+                    }
+
                     auto&& lock = write_lock{mutex_};
                     queue_.push(std::forward<T>(t));
+                    if(budget_ != nullptr)
+                        charges_.push(bytes);
                 }
 
                 auto take() -> InputT
@@ -97,13 +132,67 @@ namespace glados
                     auto ret = std::move(queue_.front());
                     queue_.pop();
 
+                    if(budget_ != nullptr && !charges_.empty())
+                    {
+                        budget_->release(charges_.front());
+                        charges_.pop();
+                    }
+
+                    if(hop_ != nullptr && !traces_.empty())
+                    {
+                        auto ctx = traces_.front();
+                        traces_.pop();
+                        lock.unlock();
+                        detail::trace_take(hop_, ctx);
+                    }
+
                     return ret;
                 }
 
+                /*
+                 * enables latency tracing for this input side, see tracer::attach().
+                 * Queued items would have no trace context, so the side has to be empty.
+                 */
+                auto set_trace_hop(trace_hop* hop) -> void
+                {
+                    auto&& lock = write_lock{mutex_};
+                    if(!queue_.empty())
+                        throw std::logic_error{"glados::pipeline::input_side: tracing has to be enabled before the first input()"};
+                    hop_ = hop;
+                }
+
+                auto traced() const noexcept -> bool
+                {
+                    return hop_ != nullptr;
+                }
+
+                /*
+                 * Charges the queued items to budget: input() blocks until the
+                 * item's bytes_of() bytes fit, take() gives them back. Queued items
+                 * would have no charge, so the side has to be empty.
+                 *
+                 * Buffers of a pool_allocator which uses the same budget are already
+                 * charged by the pool. bytes_of() must not count such pool-owned
+                 * memory, otherwise every buffer in flight is charged twice.
+                 */
+                auto set_memory_budget(memory_budget* budget, std::function<std::size_t(const InputT&)> bytes_of) -> void
+                {
+                    auto&& lock = write_lock{mutex_};
+                    if(!queue_.empty())
+                        throw std::logic_error{"glados::pipeline::input_side: the memory budget has to be set before the first input()"};
+                    budget_ = budget;
+                    bytes_of_ = std::move(bytes_of);
+                }
+
             private:
                 queue_type queue_;
                 size_type limit_;
                 mutable mutex_type mutex_;
+                std::queue<trace_context> traces_;
+                trace_hop* hop_ = nullptr;
+                memory_budget* budget_ = nullptr;
+                std::function<std::size_t(const InputT&)> bytes_of_;
+                std::queue<std::size_t> charges_;
         };
 
         template <>
@@ -27,6 +27,7 @@
 #include <utility>
 
 #include <glados/pipeline/input_side.h>
+#include <glados/pipeline/trace.h>
 
 namespace glados
 {
@@ -43,6 +44,9 @@ namespace glados
                     if(next_ == nullptr)
                         return;
 
+                    if(next_->traced())
+                        detail::trace_output();
+
                     next_->input(std::forward<T>(t));
                 }
 
@@ -53,7 +57,7 @@ namespace glados
                 }
 
             private:
-                input_side<OutputT>* next_;
+                input_side<OutputT>* next_ = nullptr;
         };
 
         template <>
@@ -23,8 +23,10 @@
 #ifndef GLADOS_PIPELINE_PIPELINE_H_
 #define GLADOS_PIPELINE_PIPELINE_H_
 
+#include <cstddef>
 #include <functional>
 #include <future>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -33,11 +35,36 @@
 #include <glados/pipeline/output_side.h>
 #include <glados/pipeline/stage.h>
 #include <glados/pipeline/task_queue.h>
+#include <glados/pipeline/trace.h>
 
 namespace glados
 {
     namespace pipeline
     {
+        namespace detail
+        {
+            /* queues which track dependencies are told when a task is finished */
+            template <class QueueT, class TaskT>
+            auto complete_task(QueueT& q, const TaskT& t, int) -> decltype(q.complete(t), void())
+            {
+                q.complete(t);
+            }
+
+            template <class QueueT, class TaskT>
+            auto complete_task(QueueT&, const TaskT&, long) noexcept -> void
+            {}
+
+            template <class QueueT, class TaskT>
+            auto abandon_task(QueueT& q, const TaskT& t, int) -> decltype(q.abandon(t), void())
+            {
+                q.abandon(t);
+            }
+
+            template <class QueueT, class TaskT>
+            auto abandon_task(QueueT&, const TaskT&, long) noexcept -> void
+            {}
+        }
+
         class pipeline_base
         {
             public:
@@ -66,6 +93,36 @@ namespace glados
                 {
                     return stage<StageT>{std::forward<Args>(args)...};
                 }
+
+                /* attaches t to the input sides of the given stages; hops are named after their position */
+                template <class... Stages>
+                auto trace(tracer& t, Stages&... stages) const -> void
+                {
+                    trace_stages(t, 0, stages...);
+                }
+
+            private:
+                auto trace_stages(tracer&, std::size_t) const noexcept -> void
+                {}
+
+                template <class First, class... Rest>
+                auto trace_stages(tracer& t, std::size_t n, First& f, Rest&... rs) const -> void
+                {
+                    trace_stage<typename First::input_type>(t, n, f);
+                    trace_stages(t, n + 1, rs...);
+                }
+
+                template <class I, class S>
+                auto trace_stage(tracer&, std::size_t, S&) const noexcept
+                -> typename std::enable_if<std::is_same<void, I>::value, void>::type
+                {}
+
+                template <class I, class S>
+                auto trace_stage(tracer& t, std::size_t n, S& s) const
+                -> typename std::enable_if<!std::is_same<void, I>::value, void>::type
+                {
+                    t.attach(s, "stage " + std::to_string(n));
+                }
         };
 
         class pipeline : public pipeline_base
@@ -102,11 +159,11 @@ namespace glados
                 std::vector<std::future<void>> futures_;
         };
 
-        template <class TaskT>
+        template <class TaskT, class QueueT = task_queue<TaskT>>
         class task_pipeline : public pipeline_base
         {
             public:
-                task_pipeline(task_queue<TaskT>* queue) noexcept
+                task_pipeline(QueueT* queue) noexcept
                 : queue_{queue}
                 {}
 
@@ -151,20 +208,29 @@ namespace glados
                     {
                         if(queue_ != nullptr)
                         {
-                            while(!queue_->empty())
+                            // several task_pipelines may share a queue, so emptiness is only known by popping
+                            while(auto task = queue_->pop_wait())
                             {
-                                auto task = queue_->pop();
-
-                                for(auto&& assign_func : assigns_)
-                                    assign_func(task);
-
-                                for(auto&& run_func : runs_)
-                                    stage_futures_.emplace_back(std::async(std::launch::async, run_func));
-
-                                for(auto&& f : stage_futures_)
-                                    f.get();
+                                try
+                                {
+                                    for(auto&& assign_func : assigns_)
+                                        assign_func(*task);
+
+                                    for(auto&& run_func : runs_)
+                                        stage_futures_.emplace_back(std::async(std::launch::async, run_func));
+
+                                    for(auto&& f : stage_futures_)
+                                        f.get();
+                                }
+                                catch(...)
+                                {
+                                    stage_futures_.clear();
+                                    detail::abandon_task(*queue_, *task, 0);
+                                    throw;
+                                }
 
                                 stage_futures_.clear();
+                                detail::complete_task(*queue_, *task, 0);
                             }
                         }
                     }
@@ -175,7 +241,7 @@ namespace glados
                 }
 
             private:
-                task_queue<TaskT>* queue_;
+                QueueT* queue_;
                 std::vector<std::future<void>> stage_futures_;
                 std::future<void> exec_future_;
 
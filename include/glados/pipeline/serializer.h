@@ -0,0 +1,94 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_SERIALIZER_H_
+#define GLADOS_PIPELINE_SERIALIZER_H_
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Serialization hooks used by the network links. Specialize serializer for
+         * your own item types; the specialization has to provide
+         *
+         *      static auto size(const T& t) -> std::size_t;
+         *      static auto write(const T& t, unsigned char* dst) -> void;
+         *      static auto read(const unsigned char* src, std::size_t n) -> T;
+         *
+         * write() must store exactly size(t) bytes, read() receives these bytes again.
+         */
+        template <class T, class = void>
+        struct serializer {};
+
+        template <class T>
+        struct serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+        {
+            static auto size(const T&) noexcept -> std::size_t
+            {
+                return sizeof(T);
+            }
+
+            static auto write(const T& t, unsigned char* dst) noexcept -> void
+            {
+                std::memcpy(dst, &t, sizeof(T));
+            }
+
+            static auto read(const unsigned char* src, std::size_t) noexcept -> T
+            {
+                auto t = T{};
+                std::memcpy(&t, src, sizeof(T));
+                return t;
+            }
+        };
+
+        template <class T, class Alloc>
+        struct serializer<std::vector<T, Alloc>, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+        {
+            static auto size(const std::vector<T, Alloc>& v) noexcept -> std::size_t
+            {
+                return v.size() * sizeof(T);
+            }
+
+            static auto write(const std::vector<T, Alloc>& v, unsigned char* dst) noexcept -> void
+            {
+                if(!v.empty())
+                    std::memcpy(dst, v.data(), v.size() * sizeof(T));
+            }
+
+            static auto read(const unsigned char* src, std::size_t n) -> std::vector<T, Alloc>
+            {
+                auto v = std::vector<T, Alloc>(n / sizeof(T));
+                if(!v.empty())
+                    std::memcpy(v.data(), src, v.size() * sizeof(T));
+                return v;
+            }
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_SERIALIZER_H_ */
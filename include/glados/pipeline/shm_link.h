@@ -0,0 +1,726 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_SHM_LINK_H_
+#define GLADOS_PIPELINE_SHM_LINK_H_
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <glados/pipeline/input_side.h>
+#include <glados/pipeline/output_side.h>
+
+/*
+ * A pipeline link between two processes on the same node. The producing process
+ * creates a named POSIX shared memory ring with shm_output_side, the consuming
+ * process opens it with shm_input_side. Payloads live inside the shared memory
+ * segment: the producer acquire()s a slot, writes into it and output()s it, the
+ * consumer take()s the same memory and returns it to the ring by destroying the
+ * buffer handle. Both sides block on futexes placed in the segment.
+ *
+ * Within a pipeline shm_output_side is the input side of the last local stage
+ * and shm_input_side the output side of the first one; both can be connect()ed
+ * and run() like stages. An empty shm_buffer is the end-of-stream item: it
+ * closes the ring when it reaches shm_output_side, and shm_input_side hands it
+ * out once the producer closed the ring or died and all slots were consumed.
+ *
+ * There is exactly one producing and one consuming process per ring. Within
+ * those processes any number of threads may share the respective side.
+ */
+
+namespace glados
+{
+    namespace pipeline
+    {
+        namespace detail
+        {
+            /* the timeout bounds how long a dead peer goes unnoticed */
+            constexpr auto shm_poll_interval = std::chrono::milliseconds{100};
+
+            inline auto futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept -> void
+            {
+                auto ts = timespec{};
+                ts.tv_sec = 0;
+                ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(shm_poll_interval).count();
+
+                // the word lives in shared memory, so the non-private futex operations are required
+                ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+            }
+
+            inline auto futex_wake(std::atomic<std::uint32_t>& word) noexcept -> void
+            {
+                ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+            }
+
+            inline auto throw_errno(const std::string& what) -> void
+            {
+                throw std::system_error{errno, std::system_category(), what};
+            }
+
+            constexpr auto shm_magic = std::uint64_t{0x474c41444f53524eu}; // "GLADOSRN"
+            constexpr auto shm_alignment = std::size_t{4096};
+
+            enum shm_slot_flags : std::uint32_t
+            {
+                slot_data = 0u,
+                slot_cancelled = 1u
+            };
+
+            struct shm_slot
+            {
+                std::uint64_t size;
+                std::uint32_t flags;
+            };
+
+            enum shm_state_flags : std::uint32_t
+            {
+                producer_closed = 1u,
+                consumer_closed = 2u
+            };
+
+            struct shm_header
+            {
+                // written last by the producer, see shm_mapping
+                std::atomic<std::uint64_t> magic;
+                std::uint64_t slots;
+                std::uint64_t slot_bytes;
+                std::uint64_t element_size;
+                std::uint64_t payload_offset;
+
+                std::atomic<std::uint32_t> state;
+                std::atomic<std::int32_t> producer_pid;
+                std::atomic<std::int32_t> consumer_pid;
+
+                // number of published slots, written by the producer
+                alignas(64) std::atomic<std::uint32_t> head;
+                std::atomic<std::uint32_t> head_waiters;
+
+                // number of slots returned by the consumer
+                alignas(64) std::atomic<std::uint32_t> tail;
+                std::atomic<std::uint32_t> tail_waiters;
+            };
+
+            static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex words must be 32 bits wide");
+            static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t), "the header is shared between processes");
+
+            inline auto round_up(std::size_t num, std::size_t multiple) noexcept -> std::size_t
+            {
+                return ((num + multiple - 1) / multiple) * multiple;
+            }
+
+            /* waits until word != value, a notification or the poll interval; callers re-check their condition */
+            inline auto shm_wait(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waiters,
+                                 std::uint32_t value) noexcept -> void
+            {
+                ++waiters;
+                if(word.load() == value)
+                    futex_wait(word, value);
+                --waiters;
+            }
+
+            inline auto shm_notify(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waiters) noexcept -> void
+            {
+                if(waiters.load() != 0)
+                    futex_wake(word);
+            }
+
+            inline auto process_alive(std::int32_t pid) noexcept -> bool
+            {
+                return pid == 0 || ::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+            }
+
+            class shm_mapping
+            {
+                public:
+                    shm_mapping() noexcept = default;
+
+                    shm_mapping(const std::string& name, std::size_t slots, std::size_t slot_bytes, std::size_t element_size)
+                    : name_{name}, owner_{true}
+                    {
+                        // the 32 bit sequence counters wrap around, so the slot count has to divide 2^32
+                        if(slots == 0 || slots > (std::size_t{1} << 31) || (slots & (slots - 1)) != 0)
+                            throw std::invalid_argument{"glados::pipeline::shm_link: the number of slots must be a power of two"};
+
+                        // an existing ring may still be in use, so it is never replaced (EEXIST)
+                        auto fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+                        if(fd == -1)
+                            throw_errno("glados::pipeline::shm_link: shm_open failed");
+
+                        auto meta_bytes = sizeof(shm_header) + slots * sizeof(shm_slot);
+                        auto payload_offset = round_up(meta_bytes, shm_alignment);
+                        auto aligned_slot_bytes = round_up(slot_bytes, shm_alignment);
+                        size_ = payload_offset + slots * aligned_slot_bytes;
+
+                        if(::ftruncate(fd, static_cast<off_t>(size_)) == -1)
+                        {
+                            auto err = errno;
+                            ::close(fd);
+                            ::shm_unlink(name_.c_str());
+                            errno = err;
+                            throw_errno("glados::pipeline::shm_link: ftruncate failed");
+                        }
+
+                        map(fd);
+
+                        auto h = new (base_) shm_header{};
+                        h->slots = slots;
+                        h->slot_bytes = aligned_slot_bytes;
+                        h->element_size = element_size;
+                        h->payload_offset = payload_offset;
+                        h->head.store(0);
+                        h->head_waiters.store(0);
+                        h->tail.store(0);
+                        h->tail_waiters.store(0);
+                        h->state.store(0);
+                        h->producer_pid.store(static_cast<std::int32_t>(::getpid()));
+                        h->consumer_pid.store(0);
+                        h->magic.store(shm_magic, std::memory_order_release);
+                    }
+
+                    /* waits up to timeout for the producer to create and initialize the ring */
+                    shm_mapping(const std::string& name, std::size_t element_size, std::chrono::milliseconds timeout)
+                    : name_{name}, owner_{false}
+                    {
+                        auto deadline = std::chrono::steady_clock::now() + timeout;
+                        auto retry = [deadline]()
+                        {
+                            if(std::chrono::steady_clock::now() >= deadline)
+                                return false;
+                            ::usleep(1000);
+                            return true;
+                        };
+
+                        while(true)
+                        {
+                            auto fd = ::shm_open(name_.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+                            if(fd == -1)
+                            {
+                                if(errno == ENOENT && retry())
+                                    continue;
+                                throw_errno("glados::pipeline::shm_link: shm_open failed");
+                            }
+
+                            auto st = stat_type{};
+                            if(::fstat(fd, &st) == -1)
+                            {
+                                auto err = errno;
+                                ::close(fd);
+                                errno = err;
+                                throw_errno("glados::pipeline::shm_link: fstat failed");
+                            }
+
+                            // the producer has not called ftruncate yet
+                            size_ = static_cast<std::size_t>(st.st_size);
+                            if(size_ < sizeof(shm_header))
+                            {
+                                ::close(fd);
+                                if(retry())
+                                    continue;
+                                throw std::runtime_error{"glados::pipeline::shm_link: segment is not initialized"};
+                            }
+
+                            map(fd);
+
+                            if(header()->magic.load(std::memory_order_acquire) == shm_magic)
+                                break;
+
+                            unmap();
+                            if(!retry())
+                                throw std::runtime_error{"glados::pipeline::shm_link: segment is not a GLADOS ring"};
+                        }
+
+                        auto h = header();
+                        auto what = static_cast<const char*>(nullptr);
+                        if(h->element_size != element_size)
+                            what = "glados::pipeline::shm_link: element size mismatch";
+                        else if(size_ < h->payload_offset + h->slots * h->slot_bytes)
+                            what = "glados::pipeline::shm_link: segment is truncated";
+
+                        if(what != nullptr)
+                        {
+                            unmap();
+                            throw std::runtime_error{what};
+                        }
+
+                        h->consumer_pid.store(static_cast<std::int32_t>(::getpid()));
+                    }
+
+                    shm_mapping(const shm_mapping&) = delete;
+                    auto operator=(const shm_mapping&) -> shm_mapping& = delete;
+
+                    ~shm_mapping()
+                    {
+                        unmap();
+
+                        if(owner_)
+                            ::shm_unlink(name_.c_str());
+                    }
+
+                    /* marks this end as closed and wakes the peer */
+                    auto close(shm_state_flags flag) noexcept -> void
+                    {
+                        auto h = header();
+                        h->state.fetch_or(flag, std::memory_order_release);
+                        futex_wake(h->head);
+                        futex_wake(h->tail);
+                    }
+
+                    /* the producer closed the ring or died */
+                    auto producer_gone() const noexcept -> bool
+                    {
+                        auto h = header();
+                        return (h->state.load(std::memory_order_acquire) & producer_closed) != 0 || !process_alive(h->producer_pid.load());
+                    }
+
+                    auto consumer_gone() const noexcept -> bool
+                    {
+                        auto h = header();
+                        return (h->state.load(std::memory_order_acquire) & consumer_closed) != 0 || !process_alive(h->consumer_pid.load());
+                    }
+
+                    auto header() const noexcept -> shm_header*
+                    {
+                        return static_cast<shm_header*>(base_);
+                    }
+
+                    auto slot(std::uint32_t seq) const noexcept -> shm_slot*
+                    {
+                        auto slots = reinterpret_cast<shm_slot*>(static_cast<char*>(base_) + sizeof(shm_header));
+                        return slots + (seq % header()->slots);
+                    }
+
+                    auto payload(std::uint32_t seq) const noexcept -> void*
+                    {
+                        auto h = header();
+                        return static_cast<char*>(base_) + h->payload_offset + (seq % h->slots) * h->slot_bytes;
+                    }
+
+                private:
+                    using stat_type = struct ::stat;
+
+                    auto map(int fd) -> void
+                    {
+                        auto p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                        auto err = errno;
+                        ::close(fd);
+
+                        if(p == MAP_FAILED)
+                        {
+                            if(owner_)
+                                ::shm_unlink(name_.c_str());
+                            errno = err;
+                            throw_errno("glados::pipeline::shm_link: mmap failed");
+                        }
+
+                        base_ = p;
+                    }
+
+                    auto unmap() noexcept -> void
+                    {
+                        if(base_ != nullptr)
+                            ::munmap(base_, size_);
+                        base_ = nullptr;
+                    }
+
+                private:
+                    std::string name_;
+                    bool owner_ = false;
+                    void* base_ = nullptr;
+                    std::size_t size_ = 0;
+            };
+
+            /* Slots may be handed back out of order; the shared counter only advances over completed runs. */
+            class shm_sequencer
+            {
+                public:
+                    explicit shm_sequencer(std::size_t slots)
+                    : done_(slots, 0), next_{0}
+                    {}
+
+                    template <class Advance>
+                    auto complete(std::uint32_t seq, Advance&& advance) -> void
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        done_[seq % done_.size()] = 1;
+
+                        auto old = next_;
+                        while(done_[next_ % done_.size()] != 0)
+                        {
+                            done_[next_ % done_.size()] = 0;
+                            ++next_;
+                        }
+
+                        if(next_ != old)
+                            advance(next_);
+                    }
+
+                private:
+                    std::mutex mutex_;
+                    std::vector<char> done_;
+                    std::uint32_t next_;
+            };
+
+            class shm_endpoint
+            {
+                public:
+                    virtual ~shm_endpoint() = default;
+                    virtual auto recycle(std::uint32_t seq) noexcept -> void = 0;
+            };
+        }
+
+        /*
+         * Move-only handle to a slot inside the shared memory ring. The slot is
+         * returned to the ring when the handle is destroyed.
+         */
+        template <class T>
+        class shm_buffer
+        {
+            public:
+                using value_type = T;
+                using size_type = std::size_t;
+
+            public:
+                shm_buffer() noexcept = default;
+
+                shm_buffer(detail::shm_endpoint* owner, std::uint32_t seq, T* data, size_type size, size_type capacity) noexcept
+                : owner_{owner}, seq_{seq}, data_{data}, size_{size}, capacity_{capacity}
+                {}
+
+                shm_buffer(const shm_buffer&) = delete;
+                auto operator=(const shm_buffer&) -> shm_buffer& = delete;
+
+                shm_buffer(shm_buffer&& other) noexcept
+                : owner_{other.owner_}, seq_{other.seq_}, data_{other.data_}, size_{other.size_}, capacity_{other.capacity_}
+                {
+                    other.owner_ = nullptr;
+                    other.data_ = nullptr;
+                }
+
+                auto operator=(shm_buffer&& other) noexcept -> shm_buffer&
+                {
+                    if(this != &other)
+                    {
+                        reset();
+                        owner_ = other.owner_;
+                        seq_ = other.seq_;
+                        data_ = other.data_;
+                        size_ = other.size_;
+                        capacity_ = other.capacity_;
+                        other.owner_ = nullptr;
+                        other.data_ = nullptr;
+                    }
+                    return *this;
+                }
+
+                ~shm_buffer()
+                {
+                    reset();
+                }
+
+                auto data() const noexcept -> T* { return data_; }
+                auto size() const noexcept -> size_type { return size_; }
+                auto capacity() const noexcept -> size_type { return capacity_; }
+                auto sequence() const noexcept -> std::uint32_t { return seq_; }
+
+                auto resize(size_type n) -> void
+                {
+                    if(n > capacity_)
+                        throw std::length_error{"glados::pipeline::shm_buffer: size exceeds slot capacity"};
+                    size_ = n;
+                }
+
+                auto operator[](size_type i) const noexcept -> T& { return data_[i]; }
+
+                explicit operator bool() const noexcept
+                {
+                    return data_ != nullptr;
+                }
+
+                /* hands the slot over without recycling it; used when the producer publishes the buffer */
+                auto release() noexcept -> void
+                {
+                    owner_ = nullptr;
+                    data_ = nullptr;
+                }
+
+                auto reset() noexcept -> void
+                {
+                    if(owner_ != nullptr)
+                        owner_->recycle(seq_);
+
+                    owner_ = nullptr;
+                    data_ = nullptr;
+                }
+
+            private:
+                detail::shm_endpoint* owner_ = nullptr;
+                std::uint32_t seq_ = 0;
+                T* data_ = nullptr;
+                size_type size_ = 0;
+                size_type capacity_ = 0;
+        };
+
+        template <class T>
+        class shm_output_side : public input_side<shm_buffer<T>>, private detail::shm_endpoint
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Shared memory payloads must be trivially copyable.");
+
+            public:
+                using input_type = shm_buffer<T>;
+                using output_type = void;
+                using buffer_type = shm_buffer<T>;
+                using size_type = std::size_t;
+
+            public:
+                /* creates the ring; capacity is the number of elements per slot. Fails with EEXIST if the name is taken. */
+                shm_output_side(const std::string& name, size_type slots, size_type capacity)
+                : input_side<buffer_type>()
+                , mapping_{name, slots, capacity * sizeof(T), sizeof(T)}
+                , sequencer_{slots}, capacity_{capacity}, reserved_{0}
+                {}
+
+                shm_output_side(const shm_output_side&) = delete;
+                auto operator=(const shm_output_side&) -> shm_output_side& = delete;
+
+                ~shm_output_side()
+                {
+                    close();
+                }
+
+                /* removes a ring left behind by a crashed producer */
+                static auto remove(const std::string& name) noexcept -> bool
+                {
+                    return ::shm_unlink(name.c_str()) == 0;
+                }
+
+                /* blocks until a free slot is available and returns it for writing */
+                auto acquire() -> buffer_type
+                {
+                    auto h = mapping_.header();
+                    auto seq = std::uint32_t{};
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                        seq = reserved_++;
+                    }
+
+                    while(true)
+                    {
+                        auto tail = h->tail.load();
+                        if(static_cast<std::uint32_t>(seq - tail) < h->slots)
+                            break;
+
+                        // seq never got a slot: recycling it would cancel the slot of an unconsumed
+                        // sequence and complete seq out of the sequencer's window. The gap it leaves
+                        // in head does not matter, nobody reads any more.
+                        if(mapping_.consumer_gone())
+                            throw std::runtime_error{"glados::pipeline::shm_output_side: the consumer has gone away"};
+
+                        detail::shm_wait(h->tail, h->tail_waiters, tail);
+                    }
+
+                    return buffer_type{this, seq, static_cast<T*>(mapping_.payload(seq)), capacity_, capacity_};
+                }
+
+                /* publishes t; an empty buffer is the end-of-stream item and closes the ring */
+                template <class U>
+                auto output(U&& t) -> typename std::enable_if<std::is_same<buffer_type, U>::value, void>::type
+                {
+                    if(!t)
+                    {
+                        close();
+                        return;
+                    }
+
+                    auto s = mapping_.slot(t.sequence());
+                    s->size = t.size();
+                    s->flags = detail::slot_data;
+
+                    auto seq = t.sequence();
+                    t.release();
+                    publish(seq);
+                }
+
+                /* the consumer sees the end of the stream once it has taken all published slots */
+                auto close() noexcept -> void
+                {
+                    mapping_.close(detail::producer_closed);
+                }
+
+                /* forwards the buffers queued by the preceding stage until the end-of-stream item */
+                auto run() -> void
+                {
+                    while(true)
+                    {
+                        auto t = this->take();
+                        auto valid = static_cast<bool>(t);
+                        output(std::move(t));
+                        if(!valid)
+                            break;
+                    }
+                }
+
+            private:
+                auto recycle(std::uint32_t seq) noexcept -> void override
+                {
+                    // an acquired buffer was dropped without being output - skip it on the consumer side
+                    auto s = mapping_.slot(seq);
+                    s->size = 0;
+                    s->flags = detail::slot_cancelled;
+                    publish(seq);
+                }
+
+                auto publish(std::uint32_t seq) noexcept -> void
+                {
+                    auto h = mapping_.header();
+                    sequencer_.complete(seq, [h](std::uint32_t head)
+                    {
+                        h->head.store(head);
+                        detail::shm_notify(h->head, h->head_waiters);
+                    });
+                }
+
+            private:
+                detail::shm_mapping mapping_;
+                detail::shm_sequencer sequencer_;
+                size_type capacity_;
+                std::mutex mutex_;
+                std::uint32_t reserved_;
+        };
+
+        template <class T>
+        class shm_input_side : public output_side<shm_buffer<T>>, private detail::shm_endpoint
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Shared memory payloads must be trivially copyable.");
+
+            public:
+                using input_type = void;
+                using output_type = shm_buffer<T>;
+                using buffer_type = shm_buffer<T>;
+                using size_type = std::size_t;
+
+            public:
+                /* opens a ring created by shm_output_side, waiting up to timeout for the producer */
+                explicit shm_input_side(const std::string& name, std::chrono::milliseconds timeout = std::chrono::seconds{5})
+                : output_side<buffer_type>()
+                , mapping_{name, sizeof(T), timeout}
+                , sequencer_{mapping_.header()->slots}, read_{0}
+                {}
+
+                shm_input_side(const shm_input_side&) = delete;
+                auto operator=(const shm_input_side&) -> shm_input_side& = delete;
+
+                ~shm_input_side()
+                {
+                    mapping_.close(detail::consumer_closed);
+                }
+
+                /*
+                 * blocks until the producer has published a slot; the returned buffer
+                 * aliases shared memory. Returns an empty buffer at the end of the stream.
+                 */
+                auto take() -> buffer_type
+                {
+                    auto h = mapping_.header();
+                    auto capacity = static_cast<size_type>(h->slot_bytes / sizeof(T));
+
+                    while(true)
+                    {
+                        auto seq = std::uint32_t{};
+                        {
+                            auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                            while(h->head.load() == read_)
+                            {
+                                // the producer publishes before closing, so head is final once the close is visible
+                                if(mapping_.producer_gone() && h->head.load() == read_)
+                                    return buffer_type{};
+
+                                detail::shm_wait(h->head, h->head_waiters, read_);
+                            }
+                            seq = read_++;
+                        }
+
+                        auto s = mapping_.slot(seq);
+                        if(s->flags == detail::slot_cancelled)
+                        {
+                            recycle(seq);
+                            continue;
+                        }
+
+                        return buffer_type{this, seq, static_cast<T*>(mapping_.payload(seq)), static_cast<size_type>(s->size), capacity};
+                    }
+                }
+
+                /* hands the received buffers to the next stage, ending with the end-of-stream item */
+                auto run() -> void
+                {
+                    while(true)
+                    {
+                        auto t = take();
+                        auto valid = static_cast<bool>(t);
+                        this->output(std::move(t));
+                        if(!valid)
+                            break;
+                    }
+                }
+
+            private:
+                auto recycle(std::uint32_t seq) noexcept -> void override
+                {
+                    auto h = mapping_.header();
+                    sequencer_.complete(seq, [h](std::uint32_t tail)
+                    {
+                        h->tail.store(tail);
+                        detail::shm_notify(h->tail, h->tail_waiters);
+                    });
+                }
+
+            private:
+                detail::shm_mapping mapping_;
+                detail::shm_sequencer sequencer_;
+                std::mutex mutex_;
+                std::uint32_t read_;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_SHM_LINK_H_ */
@@ -0,0 +1,361 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_STREAMING_TASK_QUEUE_H_
+#define GLADOS_PIPELINE_STREAMING_TASK_QUEUE_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <glados/pipeline/task_queue.h>
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * Reads fixed-size records sequentially from a memory-mapped file. Pages
+         * which have been consumed are dropped from the page cache mapping in
+         * windows of release_bytes, so the resident set stays flat no matter how
+         * large the file is. Can be used directly as generator for
+         * streaming_task_queue.
+         */
+        template <class Record>
+        class mapped_record_reader
+        {
+            static_assert(std::is_trivially_copyable<Record>::value, "Record must be trivially copyable");
+
+            public:
+                explicit mapped_record_reader(const std::string& path, std::size_t release_bytes = std::size_t{16} << 20)
+                : data_{nullptr}, size_{0}, offset_{0}, released_{0}, release_bytes_{release_bytes}
+                {
+                    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                    if(fd == -1)
+                        throw std::system_error{errno, std::system_category(), "glados::pipeline::mapped_record_reader: open failed"};
+
+                    struct stat st;
+                    if(::fstat(fd, &st) == -1)
+                    {
+                        auto err = errno;
+                        ::close(fd);
+                        throw std::system_error{err, std::system_category(), "glados::pipeline::mapped_record_reader: fstat failed"};
+                    }
+
+                    size_ = static_cast<std::size_t>(st.st_size);
+                    if(size_ % sizeof(Record) != 0)
+                    {
+                        ::close(fd);
+                        throw std::runtime_error{"glados::pipeline::mapped_record_reader: file size is not a multiple of the record size"};
+                    }
+
+                    if(size_ > 0)
+                    {
+                        auto p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if(p == MAP_FAILED)
+                        {
+                            auto err = errno;
+                            ::close(fd);
+                            throw std::system_error{err, std::system_category(), "glados::pipeline::mapped_record_reader: mmap failed"};
+                        }
+
+                        data_ = static_cast<unsigned char*>(p);
+                        ::madvise(data_, size_, MADV_SEQUENTIAL);
+                    }
+                    ::close(fd);
+                }
+
+                mapped_record_reader(mapped_record_reader&& other) noexcept
+                : data_{other.data_}, size_{other.size_}, offset_{other.offset_}
+                , released_{other.released_}, release_bytes_{other.release_bytes_}
+                {
+                    other.data_ = nullptr;
+                    other.size_ = 0;
+                }
+
+                auto operator=(mapped_record_reader&& other) noexcept -> mapped_record_reader&
+                {
+                    unmap();
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    offset_ = other.offset_;
+                    released_ = other.released_;
+                    release_bytes_ = other.release_bytes_;
+                    other.data_ = nullptr;
+                    other.size_ = 0;
+                    return *this;
+                }
+
+                mapped_record_reader(const mapped_record_reader&) = delete;
+                auto operator=(const mapped_record_reader&) -> mapped_record_reader& = delete;
+
+                ~mapped_record_reader()
+                {
+                    unmap();
+                }
+
+                auto operator()(Record& r) -> bool
+                {
+                    if(offset_ + sizeof(Record) > size_)
+                        return false;
+
+                    std::memcpy(&r, data_ + offset_, sizeof(Record));
+                    offset_ += sizeof(Record);
+
+                    if(offset_ - released_ >= release_bytes_)
+                        release();
+
+                    return true;
+                }
+
+                auto records() const noexcept -> std::size_t { return size_ / sizeof(Record); }
+                auto remaining() const noexcept -> std::size_t { return (size_ - offset_) / sizeof(Record); }
+
+            private:
+                /* drops whole pages behind the read position */
+                auto release() noexcept -> void
+                {
+                    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                    auto end = offset_ / page * page;
+                    if(end > released_)
+                    {
+                        ::madvise(data_ + released_, end - released_, MADV_DONTNEED);
+                        released_ = end;
+                    }
+                }
+
+                auto unmap() noexcept -> void
+                {
+                    if(data_ != nullptr)
+                        ::munmap(data_, size_);
+                    data_ = nullptr;
+                }
+
+            private:
+                unsigned char* data_;
+                std::size_t size_;
+                std::size_t offset_;
+                std::size_t released_;
+                std::size_t release_bytes_;
+        };
+
+        /*
+         * Task queue fed lazily by a generator. A background thread calls the
+         * generator until it returns false and keeps at most lookahead tasks
+         * buffered, so consumers can start with the first task and the memory
+         * footprint does not depend on the number of tasks. Exceptions thrown by
+         * the generator are rethrown by pop_wait() once all tasks generated
+         * before have been handed out.
+         *
+         * Offers the consumer interface of task_queue and can therefore be shared
+         * by several task_pipeline<TaskT, streaming_task_queue<TaskT>>.
+         */
+        template <class TaskT>
+        class streaming_task_queue
+        {
+            static_assert(std::is_default_constructible<TaskT>::value, "the generator fills a default-constructed TaskT");
+
+            private:
+                using lock_type = std::unique_lock<std::mutex>;
+
+            public:
+                using value_type = TaskT;
+                using size_type = std::size_t;
+                using generator_type = std::function<bool(TaskT&)>;
+
+            public:
+                explicit streaming_task_queue(generator_type generator, size_type lookahead = 1024)
+                : generator_{std::move(generator)}, lookahead_{std::max(size_type{1}, lookahead)}
+                , exhausted_{false}, stopped_{false}
+                {
+                    prefetcher_ = std::thread{&streaming_task_queue::prefetch, this};
+                }
+
+                streaming_task_queue(const streaming_task_queue&) = delete;
+                auto operator=(const streaming_task_queue&) -> streaming_task_queue& = delete;
+
+                ~streaming_task_queue()
+                {
+                    close();
+                    prefetcher_.join();
+                }
+
+                auto try_pop(TaskT& t) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return unlocked_pop(detail::assign_to(t), lock);
+                }
+
+                /* false once the generator is exhausted and all tasks have been handed out */
+                auto pop_wait(TaskT& t) -> bool
+                {
+                    return wait_and_pop(detail::assign_to(t));
+                }
+
+                /* as above, but returns nullptr instead of false */
+                auto pop_wait() -> std::unique_ptr<TaskT>
+                {
+                    auto t = std::unique_ptr<TaskT>{};
+                    wait_and_pop(detail::emplace_into(t));
+                    return t;
+                }
+
+                auto pop() -> TaskT
+                {
+                    auto t = pop_wait();
+                    if(t == nullptr)
+                        throw std::out_of_range{"glados::pipeline::streaming_task_queue: pop() called on an exhausted queue"};
+                    return std::move(*t);
+                }
+
+                /* stops generating; tasks already buffered are still handed out */
+                auto close() -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        stopped_ = true;
+                    }
+                    not_full_.notify_all();
+                }
+
+                /* true if no further task will be handed out */
+                auto empty() const -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return buffer_.empty() && exhausted_ && error_ == nullptr;
+                }
+
+                /* number of buffered tasks */
+                auto size() const -> size_type
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return buffer_.size();
+                }
+
+            private:
+                template <class Sink>
+                auto wait_and_pop(Sink&& sink) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    not_empty_.wait(lock, [this]() { return !buffer_.empty() || exhausted_; });
+                    return unlocked_pop(sink, lock);
+                }
+
+                template <class Sink>
+                auto unlocked_pop(Sink&& sink, lock_type& lock) -> bool
+                {
+                    if(buffer_.empty())
+                    {
+                        if(exhausted_ && error_ != nullptr)
+                        {
+                            auto e = error_;
+                            error_ = nullptr;
+                            std::rethrow_exception(e);
+                        }
+                        return false;
+                    }
+
+                    sink(std::move(buffer_.front()));
+                    buffer_.pop_front();
+
+                    // refill in batches instead of waking the prefetcher for every task
+                    auto wake = buffer_.size() <= lookahead_ / 2;
+                    lock.unlock();
+                    if(wake)
+                        not_full_.notify_one();
+                    return true;
+                }
+
+                auto prefetch() -> void
+                {
+                    try
+                    {
+                        auto t = TaskT{};
+                        while(true)
+                        {
+                            {
+                                auto&& lock = lock_type{mutex_};
+                                not_full_.wait(lock, [this]() { return buffer_.size() < lookahead_ || stopped_; });
+                                if(stopped_)
+                                    break;
+                            }
+
+                            // the generator runs without holding the lock
+                            if(!generator_(t))
+                                break;
+
+                            {
+                                auto&& lock = lock_type{mutex_};
+                                buffer_.push_back(std::move(t));
+                            }
+                            not_empty_.notify_one();
+                        }
+                    }
+                    catch(...)
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        error_ = std::current_exception();
+                    }
+
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        exhausted_ = true;
+                    }
+                    not_empty_.notify_all();
+                }
+
+            private:
+                generator_type generator_;
+                size_type lookahead_;
+
+                mutable std::mutex mutex_;
+                std::condition_variable not_empty_;
+                std::condition_variable not_full_;
+                std::deque<TaskT> buffer_;
+                bool exhausted_;
+                bool stopped_;
+                std::exception_ptr error_;
+
+                std::thread prefetcher_;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_STREAMING_TASK_QUEUE_H_ */
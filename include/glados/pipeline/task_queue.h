@@ -20,49 +20,841 @@
  * Authors: Jan Stephan <j.stephan@hzdr.de>
  */
 
+
 #ifndef GLADOS_PIPELINE_TASK_QUEUE_H_
 #define GLADOS_PIPELINE_TASK_QUEUE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace glados
 {
     namespace pipeline
     {
+        namespace detail
+        {
+            /*
+             * Sinks for popped tasks. The queues move a task into a sink instead of
+             * into a default-constructed temporary, so TaskT only has to be movable.
+             */
+            template <class TaskT>
+            struct assign_sink
+            {
+                auto operator()(TaskT&& v) -> void { *t = std::move(v); }
+                TaskT* t;
+            };
+
+            template <class TaskT>
+            struct emplace_sink
+            {
+                auto operator()(TaskT&& v) -> void { p->reset(new TaskT(std::move(v))); }
+                std::unique_ptr<TaskT>* p;
+            };
+
+            template <class OutputIt>
+            struct output_sink
+            {
+                template <class TaskT>
+                auto operator()(TaskT&& v) -> void { *(*out)++ = std::move(v); }
+                OutputIt* out;
+            };
+
+            template <class TaskT>
+            auto assign_to(TaskT& t) -> assign_sink<TaskT>
+            {
+                return assign_sink<TaskT>{&t};
+            }
+
+            template <class TaskT>
+            auto emplace_into(std::unique_ptr<TaskT>& p) -> emplace_sink<TaskT>
+            {
+                return emplace_sink<TaskT>{&p};
+            }
+
+            template <class OutputIt>
+            auto write_to(OutputIt& out) -> output_sink<OutputIt>
+            {
+                return output_sink<OutputIt>{&out};
+            }
+        }
+
+        /* tasks are handed out in insertion order */
+        struct fifo_scheduler {};
+
+        /*
+         * Tasks are pushed together with a key; the task whose key compares first
+         * under Compare is handed out next, ties are resolved in insertion order.
+         * Since task_pipeline fetches exactly one task per task boundary, an
+         * urgent task overtakes all waiting ones at the next boundary; running
+         * tasks are never interrupted.
+         *
+         * The order is strict and there is no aging: as long as more urgent tasks
+         * keep arriving, less urgent ones are starved. deadline_scheduler avoids
+         * this if newer tasks get later deadlines, since a waiting task's
+         * deadline eventually becomes the earliest.
+         */
+        template <class Key, class Compare = std::less<Key>>
+        struct priority_scheduler
+        {
+            using key_type = Key;
+            using compare_type = Compare;
+        };
+
+        /* earliest deadline first */
+        using deadline_scheduler = priority_scheduler<std::chrono::steady_clock::time_point>;
+
+        /* higher weights are served first */
+        using weighted_scheduler = priority_scheduler<int, std::greater<int>>;
+
+        /*
+         * Tasks are pushed together with the ids of the tasks they depend on and
+         * are handed out once all of these have completed. Id must be hashable.
+         */
+        template <class Id>
+        struct dependency_scheduler
+        {
+            using id_type = Id;
+        };
+
+        template <class TaskT, class Scheduler = fifo_scheduler>
+        class task_queue;
+
+        /*
+         * Unbounded multi-producer / multi-consumer task queue. Producers and
+         * consumers synchronize on separate locks (two-lock queue), so appending
+         * tasks does not contend with task_pipelines pulling from the same queue.
+         *
+         * A queue constructed from a std::queue is closed: consumers stop as soon
+         * as it runs empty. A default-constructed queue is open: pop_wait() blocks
+         * until a task arrives or close() is called.
+         */
         template <class TaskT>
-        class task_queue
+        class task_queue<TaskT, fifo_scheduler>
         {
+            private:
+                struct node
+                {
+                    std::atomic<node*> next{nullptr};
+                    typename std::aligned_storage<sizeof(TaskT), alignof(TaskT)>::type storage;
+
+                    auto value() noexcept -> TaskT& { return *reinterpret_cast<TaskT*>(&storage); }
+                };
+
+                using lock_type = std::unique_lock<std::mutex>;
+
             public:
-                task_queue(const std::queue<TaskT>& queue)
-                : queue_{queue}
+                using value_type = TaskT;
+                using size_type = std::size_t;
+
+            public:
+                task_queue()
+                : head_{new node{}}, tail_{head_}, size_{0}, waiters_{0}, closed_{false}
                 {}
 
+                task_queue(const std::queue<TaskT>& queue)
+                : task_queue()
+                {
+                    auto copy = queue;
+                    while(!copy.empty())
+                    {
+                        push(std::move(copy.front()));
+                        copy.pop();
+                    }
+                    closed_ = true;
+                }
+
+                task_queue(const task_queue&) = delete;
+                auto operator=(const task_queue&) -> task_queue& = delete;
+
+                ~task_queue()
+                {
+                    auto n = head_->next.load();
+                    delete head_;
+                    while(n != nullptr)
+                    {
+                        auto next = n->next.load();
+                        n->value().~TaskT();
+                        delete n;
+                        n = next;
+                    }
+                }
+
                 auto push(TaskT&& t) -> void
                 {
-                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
-                    queue_.push(std::move(t));
+                    auto n = make_node(std::move(t));
+                    link(n, n, 1);
+                }
+
+                auto push(const TaskT& t) -> void
+                {
+                    auto n = make_node(t);
+                    link(n, n, 1);
+                }
+
+                /* appends [first, last) with a single acquisition of the producer lock */
+                template <class InputIt>
+                auto push_bulk(InputIt first, InputIt last) -> void
+                {
+                    if(first == last)
+                        return;
+
+                    auto chain_head = make_node(*first);
+                    auto chain_tail = chain_head;
+                    auto count = size_type{1};
+
+                    try
+                    {
+                        for(++first; first != last; ++first)
+                        {
+                            auto n = make_node(*first);
+                            chain_tail->next.store(n, std::memory_order_relaxed);
+                            chain_tail = n;
+                            ++count;
+                        }
+                    }
+                    catch(...)
+                    {
+                        destroy_chain(chain_head);
+                        throw;
+                    }
+
+                    link(chain_head, chain_tail, count);
+                }
+
+                /* returns false if the queue is empty */
+                auto try_pop(TaskT& t) -> bool
+                {
+                    auto&& lock = lock_type{head_mutex_};
+                    return unlocked_pop(detail::assign_to(t));
+                }
+
+                /* blocks until a task is available; returns false once the queue is closed and empty */
+                auto pop_wait(TaskT& t) -> bool
+                {
+                    return wait_and_pop(detail::assign_to(t));
+                }
+
+                /* as above, but returns nullptr once the queue is closed and empty */
+                auto pop_wait() -> std::unique_ptr<TaskT>
+                {
+                    auto t = std::unique_ptr<TaskT>{};
+                    wait_and_pop(detail::emplace_into(t));
+                    return t;
+                }
+
+                /* moves up to max tasks to out; returns the number of tasks taken */
+                template <class OutputIt>
+                auto pop_bulk(OutputIt out, size_type max) -> size_type
+                {
+                    auto&& lock = lock_type{head_mutex_};
+
+                    auto count = size_type{0};
+                    while(count < max && unlocked_pop(detail::write_to(out)))
+                        ++count;
+                    return count;
                 }
 
                 auto pop() -> TaskT
                 {
-                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    auto t = std::unique_ptr<TaskT>{};
+                    {
+                        auto&& lock = lock_type{head_mutex_};
+                        if(!unlocked_pop(detail::emplace_into(t)))
+                            throw std::out_of_range{"glados::pipeline::task_queue: pop() called on an empty queue"};
+                    }
+                    return std::move(*t);
+                }
+
+                /* no more tasks will be waited for; pending tasks are still handed out */
+                auto close() -> void
+                {
+                    closed_ = true;
+                    auto&& lock = lock_type{head_mutex_};
+                    head_cv_.notify_all();
+                }
+
+                auto closed() const noexcept -> bool
+                {
+                    return closed_.load();
+                }
+
+                /* both are snapshots while other threads modify the queue */
+                auto empty() const noexcept -> bool
+                {
+                    return size_.load() == 0;
+                }
+
+                auto size() const noexcept -> size_type
+                {
+                    return size_.load();
+                }
+
+            private:
+                template <class U>
+                static auto make_node(U&& u) -> node*
+                {
+                    auto n = new node{};
+                    try
+                    {
+                        new (&n->storage) TaskT(std::forward<U>(u));
+                    }
+                    catch(...)
+                    {
+                        delete n;
+                        throw;
+                    }
+                    return n;
+                }
+
+                static auto destroy_chain(node* n) noexcept -> void
+                {
+                    while(n != nullptr)
+                    {
+                        auto next = n->next.load(std::memory_order_relaxed);
+                        n->value().~TaskT();
+                        delete n;
+                        n = next;
+                    }
+                }
+
+                auto link(node* first, node* last, size_type count) -> void
+                {
+                    {
+                        auto&& lock = lock_type{tail_mutex_};
+                        tail_->next.store(first, std::memory_order_release);
+                        tail_ = last;
+                    }
+                    size_ += count;
+
+                    if(waiters_.load() != 0)
+                    {
+                        auto&& lock = lock_type{head_mutex_};
+                        if(count == 1)
+                            head_cv_.notify_one();
+                        else
+                            head_cv_.notify_all();
+                    }
+                }
+
+                template <class Sink>
+                auto wait_and_pop(Sink&& sink) -> bool
+                {
+                    auto&& lock = lock_type{head_mutex_};
+                    while(!unlocked_pop(sink))
+                    {
+                        if(closed_.load())
+                            return false;
+
+                        ++waiters_;
+                        head_cv_.wait(lock, [this]() { return head_->next.load() != nullptr || closed_.load(); });
+                        --waiters_;
+                    }
+                    return true;
+                }
+
+                /* head_mutex_ must be held */
+                template <class Sink>
+                auto unlocked_pop(Sink&& sink) -> bool
+                {
+                    auto first = head_->next.load(std::memory_order_acquire);
+                    if(first == nullptr)
+                        return false;
+
+                    sink(std::move(first->value()));
+                    first->value().~TaskT();
+
+                    // first becomes the new dummy node
+                    auto old = head_;
+                    head_ = first;
+                    delete old;
+                    --size_;
+
+                    return true;
+                }
+
+            private:
+                std::mutex head_mutex_;
+                std::condition_variable head_cv_;
+                node* head_;
+
+                std::mutex tail_mutex_;
+                node* tail_;
+
+                std::atomic<size_type> size_;
+                std::atomic<size_type> waiters_;
+                std::atomic<bool> closed_;
+        };
+
+        /*
+         * Priority ordered task queue. All operations share one lock; the queue is
+         * open until close() is called, like the default-constructed FIFO queue.
+         */
+        template <class TaskT, class Key, class Compare>
+        class task_queue<TaskT, priority_scheduler<Key, Compare>>
+        {
+            private:
+                struct entry
+                {
+                    Key key;
+                    std::uint64_t seq;
+                    TaskT task;
+                };
+
+                using lock_type = std::unique_lock<std::mutex>;
+
+            public:
+                using value_type = TaskT;
+                using key_type = Key;
+                using size_type = std::size_t;
+
+            public:
+                task_queue(Compare comp = Compare{})
+                : comp_{comp}, seq_{0}, closed_{false}
+                {}
+
+                task_queue(const task_queue&) = delete;
+                auto operator=(const task_queue&) -> task_queue& = delete;
+
+                auto push(TaskT&& t, const Key& key) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        unlocked_push(std::move(t), key);
+                    }
+                    cv_.notify_one();
+                }
 
-                    auto ret = std::move(queue_.front());
-                    queue_.pop();
+                auto push(const TaskT& t, const Key& key) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        unlocked_push(t, key);
+                    }
+                    cv_.notify_one();
+                }
 
-                    return ret;
+                /* [first, last) is a range of std::pair<TaskT, Key> */
+                template <class InputIt>
+                auto push_bulk(InputIt first, InputIt last) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        for(; first != last; ++first)
+                            unlocked_push(first->first, first->second);
+                    }
+                    cv_.notify_all();
+                }
+
+                auto try_pop(TaskT& t) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return unlocked_pop(detail::assign_to(t));
+                }
+
+                auto pop_wait(TaskT& t) -> bool
+                {
+                    return wait_and_pop(detail::assign_to(t));
+                }
+
+                /* returns nullptr once the queue is closed and empty */
+                auto pop_wait() -> std::unique_ptr<TaskT>
+                {
+                    auto t = std::unique_ptr<TaskT>{};
+                    wait_and_pop(detail::emplace_into(t));
+                    return t;
+                }
+
+                template <class OutputIt>
+                auto pop_bulk(OutputIt out, size_type max) -> size_type
+                {
+                    auto&& lock = lock_type{mutex_};
+
+                    auto count = size_type{0};
+                    while(count < max && unlocked_pop(detail::write_to(out)))
+                        ++count;
+                    return count;
+                }
+
+                auto pop() -> TaskT
+                {
+                    auto t = std::unique_ptr<TaskT>{};
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        if(!unlocked_pop(detail::emplace_into(t)))
+                            throw std::out_of_range{"glados::pipeline::task_queue: pop() called on an empty queue"};
+                    }
+                    return std::move(*t);
+                }
+
+                auto close() -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        closed_ = true;
+                    }
+                    cv_.notify_all();
+                }
+
+                auto closed() const -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return closed_;
                 }
 
                 auto empty() const -> bool
                 {
-                    return queue_.empty();
+                    auto&& lock = lock_type{mutex_};
+                    return heap_.empty();
+                }
+
+                auto size() const -> size_type
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return heap_.size();
+                }
+
+            private:
+                /* heap order: the most urgent entry is at the front */
+                auto less_urgent(const entry& a, const entry& b) const -> bool
+                {
+                    if(comp_(b.key, a.key))
+                        return true;
+                    if(comp_(a.key, b.key))
+                        return false;
+                    return a.seq > b.seq;
+                }
+
+                template <class U>
+                auto unlocked_push(U&& t, const Key& key) -> void
+                {
+                    heap_.push_back(entry{key, seq_++, std::forward<U>(t)});
+                    std::push_heap(std::begin(heap_), std::end(heap_), [this](const entry& a, const entry& b) { return less_urgent(a, b); });
+                }
+
+                template <class Sink>
+                auto wait_and_pop(Sink&& sink) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    cv_.wait(lock, [this]() { return !heap_.empty() || closed_; });
+                    return unlocked_pop(sink);
+                }
+
+                template <class Sink>
+                auto unlocked_pop(Sink&& sink) -> bool
+                {
+                    if(heap_.empty())
+                        return false;
+
+                    std::pop_heap(std::begin(heap_), std::end(heap_), [this](const entry& a, const entry& b) { return less_urgent(a, b); });
+                    sink(std::move(heap_.back().task));
+                    heap_.pop_back();
+                    return true;
                 }
 
             private:
-                std::queue<TaskT> queue_;
-                std::mutex mutex_;
+                mutable std::mutex mutex_;
+                std::condition_variable cv_;
+                std::vector<entry> heap_;
+                Compare comp_;
+                std::uint64_t seq_;
+                bool closed_;
+        };
+
+        /*
+         * Dependency ordered task queue. The id of a task is obtained from the
+         * function passed to the constructor. A task becomes ready when all of its
+         * prerequisites were completed; ready tasks are handed out in the order
+         * they became ready, so task_pipelines sharing the queue run independent
+         * tasks concurrently. task_pipeline calls complete() after the last stage
+         * finished a task. Like the priority queue it is open until close() is
+         * called; prerequisites may be pushed after their dependents. Ids of
+         * completed tasks are remembered so that later pushes can name them;
+         * forget() drops an id once no further task depends on it.
+         *
+         * Every task taken out with try_pop(), pop(), pop_bulk() or pop_wait() has
+         * to be handed back through complete() or abandon(). While a popped task is
+         * neither, pop_wait() keeps waiting for it after close() instead of
+         * reporting the blocked tasks which can no longer become ready.
+         */
+        template <class TaskT, class Id>
+        class task_queue<TaskT, dependency_scheduler<Id>>
+        {
+            private:
+                struct blocked_task
+                {
+                    TaskT task;
+                    std::size_t missing;
+                };
+
+                using lock_type = std::unique_lock<std::mutex>;
+
+            public:
+                using value_type = TaskT;
+                using id_type = Id;
+                using size_type = std::size_t;
+                using id_function = std::function<Id(const TaskT&)>;
+
+            public:
+                explicit task_queue(id_function id_of)
+                : id_of_{std::move(id_of)}, closed_{false}
+                {}
+
+                task_queue(const task_queue&) = delete;
+                auto operator=(const task_queue&) -> task_queue& = delete;
+
+                /* throws std::invalid_argument if a task with the same id is still pending */
+                auto push(TaskT t, const std::vector<Id>& prerequisites = {}) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        auto id = id_of_(t);
+                        if(pending_.count(id) != 0)
+                            throw std::invalid_argument{"glados::pipeline::task_queue: a task with this id is already pending"};
+
+                        pending_.insert(id);
+                        auto missing = std::size_t{0};
+                        auto seen = std::unordered_set<Id>{};
+                        for(auto&& p : prerequisites)
+                        {
+                            if(done_.count(p) != 0 || !seen.insert(p).second)
+                                continue;
+
+                            dependents_[p].push_back(id);
+                            ++missing;
+                        }
+
+                        if(missing == 0)
+                            ready_.push_back(std::move(t));
+                        else
+                            blocked_.emplace(id, blocked_task{std::move(t), missing});
+                    }
+                    cv_.notify_all();
+                }
+
+                auto try_pop(TaskT& t) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return unlocked_pop(detail::assign_to(t));
+                }
+
+                /*
+                 * blocks until a task is ready; returns false once the queue is closed
+                 * and every task was handed out. Throws std::logic_error if the
+                 * remaining tasks can never become ready (unknown prerequisites,
+                 * cycles or failed prerequisites).
+                 */
+                auto pop_wait(TaskT& t) -> bool
+                {
+                    return wait_and_pop(detail::assign_to(t));
+                }
+
+                /* as above, but returns nullptr instead of false */
+                auto pop_wait() -> std::unique_ptr<TaskT>
+                {
+                    auto t = std::unique_ptr<TaskT>{};
+                    wait_and_pop(detail::emplace_into(t));
+                    return t;
+                }
+
+                template <class OutputIt>
+                auto pop_bulk(OutputIt out, size_type max) -> size_type
+                {
+                    auto&& lock = lock_type{mutex_};
+
+                    auto count = size_type{0};
+                    while(count < max && unlocked_pop(detail::write_to(out)))
+                        ++count;
+                    return count;
+                }
+
+                auto pop() -> TaskT
+                {
+                    auto t = std::unique_ptr<TaskT>{};
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        if(!unlocked_pop(detail::emplace_into(t)))
+                            throw std::out_of_range{"glados::pipeline::task_queue: pop() called on an empty queue"};
+                    }
+                    return std::move(*t);
+                }
+
+                /*
+                 * t was popped from this queue and is finished; its dependents may run.
+                 * Throws std::logic_error if t is not running.
+                 */
+                auto complete(const TaskT& t) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        auto id = id_of_(t);
+                        unlocked_finish(id, "complete");
+                        pending_.erase(id);
+                        unlocked_mark_done(id);
+                    }
+                    cv_.notify_all();
+                }
+
+                /*
+                 * t was popped from this queue but failed; its dependents stay blocked
+                 * until it is pushed again. Throws std::logic_error if t is not running.
+                 */
+                auto abandon(const TaskT& t) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        auto id = id_of_(t);
+                        unlocked_finish(id, "abandon");
+                        pending_.erase(id);
+                    }
+                    cv_.notify_all();
+                }
+
+                /* id is satisfied without a task in this queue, e.g. by an earlier run */
+                auto mark_done(const Id& id) -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        unlocked_mark_done(id);
+                    }
+                    cv_.notify_all();
+                }
+
+                /* tasks pushed afterwards naming id wait for it again */
+                auto forget(const Id& id) -> void
+                {
+                    auto&& lock = lock_type{mutex_};
+                    done_.erase(id);
+                }
+
+                auto close() -> void
+                {
+                    {
+                        auto&& lock = lock_type{mutex_};
+                        closed_ = true;
+                    }
+                    cv_.notify_all();
+                }
+
+                auto closed() const -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return closed_;
+                }
+
+                /* ready and blocked tasks */
+                auto empty() const -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return ready_.empty() && blocked_.empty();
+                }
+
+                auto size() const -> size_type
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return ready_.size() + blocked_.size();
+                }
+
+                auto ready() const -> size_type
+                {
+                    auto&& lock = lock_type{mutex_};
+                    return ready_.size();
+                }
+
+            private:
+                template <class Sink>
+                auto wait_and_pop(Sink&& sink) -> bool
+                {
+                    auto&& lock = lock_type{mutex_};
+                    cv_.wait(lock, [this]() { return !ready_.empty() || (closed_ && (blocked_.empty() || running_.empty())); });
+
+                    if(unlocked_pop(sink))
+                        return true;
+
+                    if(!blocked_.empty())
+                        throw std::logic_error{"glados::pipeline::task_queue: the prerequisites of the remaining tasks cannot be satisfied"};
+
+                    return false;
+                }
+
+                template <class Sink>
+                auto unlocked_pop(Sink&& sink) -> bool
+                {
+                    if(ready_.empty())
+                        return false;
+
+                    auto id = id_of_(ready_.front());
+                    running_.insert(id);
+                    try
+                    {
+                        sink(std::move(ready_.front()));
+                    }
+                    catch(...)
+                    {
+                        running_.erase(id);
+                        throw;
+                    }
+                    ready_.pop_front();
+                    return true;
+                }
+
+                auto unlocked_finish(const Id& id, const char* caller) -> void
+                {
+                    if(running_.erase(id) == 0)
+                        throw std::logic_error{std::string{"glados::pipeline::task_queue: "} + caller + "() called for a task which is not running"};
+                }
+
+                auto unlocked_mark_done(const Id& id) -> void
+                {
+                    if(!done_.insert(id).second)
+                        return;
+
+                    auto it = dependents_.find(id);
+                    if(it == std::end(dependents_))
+                        return;
+
+                    for(auto&& d : it->second)
+                    {
+                        auto b = blocked_.find(d);
+                        if(b == std::end(blocked_) || --b->second.missing != 0)
+                            continue;
+
+                        ready_.push_back(std::move(b->second.task));
+                        blocked_.erase(b);
+                    }
+                    dependents_.erase(it);
+                }
+
+            private:
+                mutable std::mutex mutex_;
+                std::condition_variable cv_;
+                id_function id_of_;
+
+                std::deque<TaskT> ready_;
+                std::unordered_map<Id, blocked_task> blocked_;
+                std::unordered_map<Id, std::vector<Id>> dependents_;
+                std::unordered_set<Id> done_;
+                std::unordered_set<Id> pending_;
+                std::unordered_set<Id> running_;
+
+                bool closed_;
         };
     }
 }
@@ -0,0 +1,777 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_TCP_LINK_H_
+#define GLADOS_PIPELINE_TCP_LINK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <endian.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <glados/pipeline/input_side.h>
+#include <glados/pipeline/output_side.h>
+#include <glados/pipeline/serializer.h>
+
+/*
+ * A pipeline link between two nodes. The downstream node listens with a
+ * tcp_input_side, the upstream node connects to it with a tcp_output_side.
+ * Items are distributed round-robin over several connections and collected in
+ * the same order, so the item order of the stream is preserved.
+ *
+ * Flow control is credit based: the receiver grants each connection a share of
+ * its input limit, the sender only transmits while it holds credits, and every
+ * take() on the receiving side hands one credit back. Sending and receiving
+ * happen on dedicated threads, so serialisation and transfer overlap with the
+ * computation of the stages on both ends.
+ *
+ * Within a pipeline tcp_output_side is the input side of the last local stage
+ * and tcp_input_side the output side of the first one; both can be connect()ed
+ * and run() like stages. The end-of-stream item (see end_of_stream) is not
+ * sent: tcp_output_side::run() closes the connections when it arrives, and
+ * tcp_input_side hands it out once the sender closed all connections.
+ *
+ * Wire format (per connection):
+ *      sender   -> receiver: [u64 payload size, big endian][payload] ...
+ *      receiver -> sender:   [u32 credits, big endian] ...
+ */
+
+namespace glados
+{
+    namespace pipeline
+    {
+        /*
+         * The item which ends a stream sent over a network link. By default a
+         * value-initialized item ends the stream; specialize end_of_stream for
+         * item types that mark the end differently, e.g. with a validity flag:
+         *
+         *      static auto make() -> T;
+         *      static auto is(const T& t) -> bool;
+         */
+        template <class T>
+        struct end_of_stream
+        {
+            static auto make() -> T
+            {
+                return T{};
+            }
+
+            static auto is(const T& t) -> bool
+            {
+                return t == T{};
+            }
+        };
+
+        namespace detail
+        {
+            inline auto throw_socket_error(const std::string& what) -> void
+            {
+                throw std::system_error{errno, std::system_category(), what};
+            }
+
+            class socket_handle
+            {
+                public:
+                    socket_handle() noexcept = default;
+                    explicit socket_handle(int fd) noexcept : fd_{fd} {}
+
+                    socket_handle(const socket_handle&) = delete;
+                    auto operator=(const socket_handle&) -> socket_handle& = delete;
+
+                    socket_handle(socket_handle&& other) noexcept : fd_{other.fd_} { other.fd_ = -1; }
+
+                    auto operator=(socket_handle&& other) noexcept -> socket_handle&
+                    {
+                        if(this != &other)
+                        {
+                            close();
+                            fd_ = other.fd_;
+                            other.fd_ = -1;
+                        }
+                        return *this;
+                    }
+
+                    ~socket_handle() { close(); }
+
+                    auto get() const noexcept -> int { return fd_; }
+
+                    auto close() noexcept -> void
+                    {
+                        if(fd_ != -1)
+                            ::close(fd_);
+                        fd_ = -1;
+                    }
+
+                private:
+                    int fd_ = -1;
+            };
+
+            inline auto send_all(int fd, const void* buf, std::size_t n) -> void
+            {
+                auto p = static_cast<const unsigned char*>(buf);
+                while(n > 0)
+                {
+                    auto ret = ::send(fd, p, n, MSG_NOSIGNAL);
+                    if(ret == -1)
+                    {
+                        if(errno == EINTR)
+                            continue;
+                        throw_socket_error("glados::pipeline::tcp_link: send failed");
+                    }
+                    p += ret;
+                    n -= static_cast<std::size_t>(ret);
+                }
+            }
+
+            /* returns false if the peer closed the connection before the first byte */
+            inline auto recv_all(int fd, void* buf, std::size_t n) -> bool
+            {
+                auto p = static_cast<unsigned char*>(buf);
+                auto first = true;
+                while(n > 0)
+                {
+                    auto ret = ::recv(fd, p, n, 0);
+                    if(ret == -1)
+                    {
+                        if(errno == EINTR)
+                            continue;
+                        throw_socket_error("glados::pipeline::tcp_link: recv failed");
+                    }
+
+                    if(ret == 0)
+                    {
+                        if(first)
+                            return false;
+                        throw std::runtime_error{"glados::pipeline::tcp_link: connection closed in the middle of a frame"};
+                    }
+
+                    first = false;
+                    p += ret;
+                    n -= static_cast<std::size_t>(ret);
+                }
+                return true;
+            }
+
+            inline auto set_nodelay(int fd) noexcept -> void
+            {
+                auto flag = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+            }
+
+            inline auto connect_to(const std::string& host, std::uint16_t port) -> socket_handle
+            {
+                auto hints = addrinfo{};
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+
+                auto res = static_cast<addrinfo*>(nullptr);
+                auto port_str = std::to_string(port);
+                auto err = ::getaddrinfo(host.c_str(), port_str.c_str(), &hints, &res);
+                if(err != 0)
+                    throw std::runtime_error{std::string{"glados::pipeline::tcp_link: "} + ::gai_strerror(err)};
+
+                auto sock = socket_handle{};
+                auto saved = 0;
+                for(auto ai = res; ai != nullptr; ai = ai->ai_next)
+                {
+                    sock = socket_handle{::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol)};
+                    if(sock.get() == -1)
+                    {
+                        saved = errno;
+                        continue;
+                    }
+
+                    if(::connect(sock.get(), ai->ai_addr, ai->ai_addrlen) == 0)
+                        break;
+
+                    saved = errno;
+                    sock.close();
+                }
+                ::freeaddrinfo(res);
+
+                if(sock.get() == -1)
+                {
+                    errno = saved;
+                    throw_socket_error("glados::pipeline::tcp_link: connect failed");
+                }
+
+                set_nodelay(sock.get());
+                return sock;
+            }
+
+            /* binds to address (every interface if it is empty) and listens */
+            inline auto listen_on(const std::string& address, std::uint16_t port, int backlog) -> socket_handle
+            {
+                auto sock = socket_handle{};
+                auto err = 0;
+                auto flag = 1;
+                if(address.empty())
+                {
+                    // one dual-stack socket if possible, IPv4 only otherwise
+                    sock = socket_handle{::socket(AF_INET6, SOCK_STREAM, 0)};
+                    auto v6 = (sock.get() != -1);
+                    if(!v6)
+                        sock = socket_handle{::socket(AF_INET, SOCK_STREAM, 0)};
+                    if(sock.get() == -1)
+                        throw_socket_error("glados::pipeline::tcp_input_side: socket failed");
+
+                    ::setsockopt(sock.get(), SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+                    if(v6)
+                    {
+                        auto off = 0;
+                        ::setsockopt(sock.get(), IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+
+                        auto addr = sockaddr_in6{};
+                        addr.sin6_family = AF_INET6;
+                        addr.sin6_addr = in6addr_any;
+                        addr.sin6_port = htons(port);
+                        err = ::bind(sock.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                    }
+                    else
+                    {
+                        auto addr = sockaddr_in{};
+                        addr.sin_family = AF_INET;
+                        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+                        addr.sin_port = htons(port);
+                        err = ::bind(sock.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                    }
+                }
+                else
+                {
+                    auto hints = addrinfo{};
+                    hints.ai_family = AF_UNSPEC;
+                    hints.ai_socktype = SOCK_STREAM;
+                    hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+
+                    auto res = static_cast<addrinfo*>(nullptr);
+                    auto port_str = std::to_string(port);
+                    auto gai = ::getaddrinfo(address.c_str(), port_str.c_str(), &hints, &res);
+                    if(gai != 0)
+                        throw std::runtime_error{std::string{"glados::pipeline::tcp_input_side: "} + ::gai_strerror(gai)};
+
+                    auto saved = 0;
+                    err = -1;
+                    for(auto ai = res; ai != nullptr && err == -1; ai = ai->ai_next)
+                    {
+                        sock = socket_handle{::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol)};
+                        if(sock.get() == -1)
+                        {
+                            saved = errno;
+                            continue;
+                        }
+
+                        ::setsockopt(sock.get(), SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+                        err = ::bind(sock.get(), ai->ai_addr, ai->ai_addrlen);
+                        if(err == -1)
+                        {
+                            saved = errno;
+                            sock.close();
+                        }
+                    }
+                    ::freeaddrinfo(res);
+                    errno = saved;
+                }
+
+                if(err == -1)
+                    throw_socket_error("glados::pipeline::tcp_input_side: bind failed");
+
+                if(::listen(sock.get(), backlog) == -1)
+                    throw_socket_error("glados::pipeline::tcp_input_side: listen failed");
+
+                return sock;
+            }
+        }
+
+        template <class T, class Serializer = serializer<T>, class EndOfStream = end_of_stream<T>>
+        class tcp_output_side : public input_side<T>
+        {
+            public:
+                using input_type = T;
+                using output_type = void;
+                using size_type = std::size_t;
+
+            private:
+                struct connection
+                {
+                    detail::socket_handle sock;
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                    std::deque<T> queue;
+                    bool closing = false;
+                    bool done = false;
+                    std::exception_ptr error;
+                    std::uint32_t credits = 0;
+                    std::thread writer;
+                };
+
+            public:
+                /*
+                 * connections: number of parallel TCP connections
+                 * batch:       maximum number of items combined into a single write
+                 */
+                tcp_output_side(const std::string& host, std::uint16_t port, size_type connections = 1, size_type batch = 16)
+                : input_side<T>(), batch_{std::max(size_type{1}, batch)}, next_{0}
+                {
+                    if(connections == 0)
+                        throw std::invalid_argument{"glados::pipeline::tcp_output_side: at least one connection is required"};
+
+                    for(auto i = size_type{0}; i < connections; ++i)
+                    {
+                        connections_.emplace_back(new connection{});
+                        connections_.back()->sock = detail::connect_to(host, port);
+                    }
+
+                    for(auto&& c : connections_)
+                        c->writer = std::thread{&tcp_output_side::write_loop, this, c.get()};
+                }
+
+                tcp_output_side(const tcp_output_side&) = delete;
+                auto operator=(const tcp_output_side&) -> tcp_output_side& = delete;
+
+                ~tcp_output_side()
+                {
+                    close();
+                }
+
+                template <class U>
+                auto output(U&& t) -> typename std::enable_if<std::is_same<T, U>::value, void>::type
+                {
+                    auto c = connections_[next_.fetch_add(1) % connections_.size()].get();
+
+                    auto&& lock = std::unique_lock<std::mutex>{c->mutex};
+                    // keep at most two batches per connection in flight locally
+                    c->cv.wait(lock, [this, c]() { return c->queue.size() < 2 * batch_ || c->error != nullptr; });
+
+                    if(c->error != nullptr)
+                        std::rethrow_exception(c->error);
+
+                    c->queue.push_back(std::forward<U>(t));
+                    lock.unlock();
+                    c->cv.notify_all();
+                }
+
+                /*
+                 * sends all queued items and closes the connections; called by the
+                 * destructor. If the receiver does not take the items within linger
+                 * the connections are shut down and the remaining items are dropped.
+                 */
+                auto close(std::chrono::milliseconds linger = std::chrono::seconds{10}) -> void
+                {
+                    for(auto&& c : connections_)
+                    {
+                        {
+                            auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                            c->closing = true;
+                        }
+                        c->cv.notify_all();
+                    }
+
+                    auto deadline = std::chrono::steady_clock::now() + linger;
+                    for(auto&& c : connections_)
+                    {
+                        auto&& lock = std::unique_lock<std::mutex>{c->mutex};
+                        if(!c->cv.wait_until(lock, deadline, [&c]() { return c->done; }))
+                            ::shutdown(c->sock.get(), SHUT_RDWR); // unblocks the writer waiting for credits
+                    }
+
+                    for(auto&& c : connections_)
+                    {
+                        if(c->writer.joinable())
+                            c->writer.join();
+                    }
+                }
+
+                /* sends the items queued by the preceding stage until the end-of-stream item */
+                auto run() -> void
+                {
+                    while(true)
+                    {
+                        auto t = this->take();
+                        if(EndOfStream::is(t))
+                            break;
+                        output(std::move(t));
+                    }
+                    close();
+                }
+
+            private:
+                auto write_loop(connection* c) noexcept -> void
+                {
+                    auto buffer = std::vector<unsigned char>{};
+                    auto batch = std::vector<T>{};
+                    batch.reserve(batch_);
+
+                    try
+                    {
+                        while(true)
+                        {
+                            {
+                                auto&& lock = std::unique_lock<std::mutex>{c->mutex};
+                                c->cv.wait(lock, [c]() { return !c->queue.empty() || c->closing; });
+
+                                if(c->queue.empty() && c->closing)
+                                    break;
+                            }
+
+                            // block for credits only if there is something to send
+                            receive_credits(c, c->credits == 0);
+
+                            {
+                                auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                                auto n = std::min({c->queue.size(), batch_, static_cast<size_type>(c->credits)});
+                                for(auto i = size_type{0}; i < n; ++i)
+                                {
+                                    batch.push_back(std::move(c->queue.front()));
+                                    c->queue.pop_front();
+                                }
+                            }
+                            c->cv.notify_all();
+
+                            auto bytes = size_type{0};
+                            for(auto&& t : batch)
+                                bytes += sizeof(std::uint64_t) + Serializer::size(t);
+
+                            buffer.resize(bytes);
+                            auto p = buffer.data();
+                            for(auto&& t : batch)
+                            {
+                                auto n = Serializer::size(t);
+                                auto be = htobe64(static_cast<std::uint64_t>(n));
+                                std::memcpy(p, &be, sizeof(be));
+                                p += sizeof(be);
+                                Serializer::write(t, p);
+                                p += n;
+                            }
+
+                            detail::send_all(c->sock.get(), buffer.data(), buffer.size());
+                            c->credits -= static_cast<std::uint32_t>(batch.size());
+                            batch.clear();
+                        }
+
+                        ::shutdown(c->sock.get(), SHUT_WR);
+                    }
+                    catch(...)
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                        c->error = std::current_exception();
+                        c->queue.clear();
+                    }
+
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                        c->done = true;
+                    }
+                    c->cv.notify_all();
+                }
+
+                auto receive_credits(connection* c, bool block) -> void
+                {
+                    auto grant = std::uint32_t{};
+                    while(true)
+                    {
+                        auto ret = ::recv(c->sock.get(), &grant, sizeof(grant), (block ? 0 : MSG_DONTWAIT) | MSG_PEEK);
+                        if(ret == -1)
+                        {
+                            if(errno == EINTR)
+                                continue;
+                            if(!block && (errno == EAGAIN || errno == EWOULDBLOCK))
+                                return;
+                            detail::throw_socket_error("glados::pipeline::tcp_output_side: receiving credits failed");
+                        }
+
+                        if(ret == 0)
+                            throw std::runtime_error{"glados::pipeline::tcp_output_side: receiver closed the connection"};
+
+                        if(static_cast<std::size_t>(ret) < sizeof(grant) && !block)
+                            return;
+
+                        if(!detail::recv_all(c->sock.get(), &grant, sizeof(grant)))
+                            throw std::runtime_error{"glados::pipeline::tcp_output_side: receiver closed the connection"};
+
+                        c->credits += be32toh(grant);
+                        block = false;
+                    }
+                }
+
+            private:
+                std::vector<std::unique_ptr<connection>> connections_;
+                size_type batch_;
+                std::atomic<size_type> next_;
+        };
+
+        template <class T, class Serializer = serializer<T>, class EndOfStream = end_of_stream<T>>
+        class tcp_input_side : public output_side<T>
+        {
+            public:
+                using input_type = void;
+                using output_type = T;
+                using size_type = std::size_t;
+
+            private:
+                struct connection
+                {
+                    detail::socket_handle sock;
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                    std::deque<T> queue;
+                    bool closed = false;
+                    std::exception_ptr error;
+                    std::mutex send_mutex;
+                    std::uint32_t credits = 0;
+                    std::uint32_t pending_credits = 0;
+                    std::thread reader;
+                };
+
+            public:
+                /* frames larger than this are rejected unless the constructor says otherwise */
+                static constexpr auto default_max_frame = size_type{1} << 30;
+
+            public:
+                /*
+                 * port:        0 selects an ephemeral port, see port()
+                 * connections: number of connections the sender will open
+                 * limit:       maximum number of items buffered on this side, like input_side's limit;
+                 *              split over the connections, so it must not be smaller than connections
+                 * max_frame:   largest accepted frame in bytes; a larger frame header fails the
+                 *              connection instead of allocating what the peer claims
+                 *
+                 * Listens on every interface; pass an address to restrict it.
+                 */
+                tcp_input_side(std::uint16_t port = 0, size_type connections = 1, size_type limit = 64, size_type max_frame = default_max_frame)
+                : tcp_input_side(std::string{}, port, connections, limit, max_frame)
+                {}
+
+                /* listens on address only, e.g. "127.0.0.1" or the address of the data network */
+                tcp_input_side(const std::string& address, std::uint16_t port, size_type connections = 1, size_type limit = 64,
+                               size_type max_frame = default_max_frame)
+                : output_side<T>(), connections_count_{std::max(size_type{1}, connections)}, limit_{limit}, max_frame_{max_frame}, next_{0}
+                {
+                    if(limit_ < connections_count_)
+                        throw std::invalid_argument{"glados::pipeline::tcp_input_side: the limit must allow one item per connection"};
+
+                    listener_ = detail::listen_on(address, port, static_cast<int>(connections_count_));
+                }
+
+                tcp_input_side(const tcp_input_side&) = delete;
+                auto operator=(const tcp_input_side&) -> tcp_input_side& = delete;
+
+                ~tcp_input_side()
+                {
+                    for(auto&& c : connections_)
+                        ::shutdown(c->sock.get(), SHUT_RDWR);
+
+                    for(auto&& c : connections_)
+                    {
+                        if(c->reader.joinable())
+                            c->reader.join();
+                    }
+                }
+
+                auto port() const -> std::uint16_t
+                {
+                    auto addr = sockaddr_storage{};
+                    auto len = socklen_t{sizeof(addr)};
+                    if(::getsockname(listener_.get(), reinterpret_cast<sockaddr*>(&addr), &len) == -1)
+                        detail::throw_socket_error("glados::pipeline::tcp_input_side: getsockname failed");
+
+                    if(addr.ss_family == AF_INET6)
+                        return ntohs(reinterpret_cast<sockaddr_in6*>(&addr)->sin6_port);
+                    return ntohs(reinterpret_cast<sockaddr_in*>(&addr)->sin_port);
+                }
+
+                /* waits for all connections of the sender; take() calls this implicitly */
+                auto accept() -> void
+                {
+                    std::call_once(accepted_, [this]()
+                    {
+                        for(auto i = size_type{0}; i < connections_count_; ++i)
+                        {
+                            auto fd = -1;
+                            do
+                            {
+                                fd = ::accept(listener_.get(), nullptr, nullptr);
+                            } while(fd == -1 && errno == EINTR);
+
+                            if(fd == -1)
+                                detail::throw_socket_error("glados::pipeline::tcp_input_side: accept failed");
+
+                            // the first limit % connections connections get one credit more
+                            connections_.emplace_back(new connection{});
+                            auto c = connections_.back().get();
+                            c->sock = detail::socket_handle{fd};
+                            c->credits = static_cast<std::uint32_t>(limit_ / connections_count_ + (i < limit_ % connections_count_ ? 1 : 0));
+                            detail::set_nodelay(fd);
+                            send_credits(c, c->credits);
+                        }
+                        listener_.close();
+
+                        for(auto&& c : connections_)
+                            c->reader = std::thread{&tcp_input_side::read_loop, this, c.get()};
+                    });
+                }
+
+                /* returns the end-of-stream item once the sender closed all connections */
+                auto take() -> T
+                {
+                    auto end = false;
+                    return receive(end);
+                }
+
+                /* hands the received items to the next stage, ending with the end-of-stream item */
+                auto run() -> void
+                {
+                    auto end = false;
+                    while(!end)
+                        this->output(receive(end));
+                }
+
+            private:
+                auto receive(bool& end) -> T
+                {
+                    accept();
+
+                    auto&& take_lock = std::lock_guard<std::mutex>{take_mutex_};
+                    auto c = connections_[next_ % connections_.size()].get();
+
+                    auto&& lock = std::unique_lock<std::mutex>{c->mutex};
+                    c->cv.wait(lock, [c]() { return !c->queue.empty() || c->closed; });
+
+                    // items are distributed round-robin, so the stream ends at the first drained connection
+                    if(c->queue.empty())
+                    {
+                        if(c->error != nullptr)
+                            std::rethrow_exception(c->error);
+
+                        end = true;
+                        return EndOfStream::make();
+                    }
+
+                    auto ret = std::move(c->queue.front());
+                    c->queue.pop_front();
+                    lock.unlock();
+                    ++next_;
+
+                    // credits are returned in small batches to save round trips
+                    {
+                        auto&& send_lock = std::lock_guard<std::mutex>{c->send_mutex};
+                        ++c->pending_credits;
+                        if(c->pending_credits >= std::max(std::uint32_t{1}, c->credits / 4))
+                        {
+                            try
+                            {
+                                send_credits(c, c->pending_credits);
+                            }
+                            catch(...)
+                            {
+                                // the sender is gone; the items it sent can still be taken
+                            }
+                            c->pending_credits = 0;
+                        }
+                    }
+
+                    return ret;
+                }
+
+                static auto send_credits(connection* c, std::uint32_t n) -> void
+                {
+                    auto be = htobe32(n);
+                    detail::send_all(c->sock.get(), &be, sizeof(be));
+                }
+
+                auto read_loop(connection* c) noexcept -> void
+                {
+                    auto buffer = std::vector<unsigned char>{};
+                    try
+                    {
+                        while(true)
+                        {
+                            auto be = std::uint64_t{};
+                            if(!detail::recv_all(c->sock.get(), &be, sizeof(be)))
+                                break;
+
+                            auto n = be64toh(be);
+                            if(n > max_frame_)
+                                throw std::runtime_error{"glados::pipeline::tcp_input_side: frame exceeds the maximum frame size"};
+
+                            auto bytes = static_cast<size_type>(n);
+                            buffer.resize(bytes);
+                            if(bytes > 0 && !detail::recv_all(c->sock.get(), buffer.data(), bytes))
+                                throw std::runtime_error{"glados::pipeline::tcp_input_side: connection closed in the middle of a frame"};
+
+                            auto t = Serializer::read(buffer.data(), bytes);
+                            {
+                                auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                                c->queue.push_back(std::move(t));
+                            }
+                            c->cv.notify_all();
+                        }
+                    }
+                    catch(...)
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                        c->error = std::current_exception();
+                    }
+
+                    {
+                        auto&& lock = std::lock_guard<std::mutex>{c->mutex};
+                        c->closed = true;
+                    }
+                    c->cv.notify_all();
+                }
+
+            private:
+                detail::socket_handle listener_;
+                std::vector<std::unique_ptr<connection>> connections_;
+                size_type connections_count_;
+                size_type limit_;
+                size_type max_frame_;
+                std::once_flag accepted_;
+                std::mutex take_mutex_;
+                size_type next_;
+        };
+    }
+}
+
+#endif /* GLADOS_PIPELINE_TCP_LINK_H_ */
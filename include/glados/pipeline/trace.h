@@ -0,0 +1,308 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#ifndef GLADOS_PIPELINE_TRACE_H_
+#define GLADOS_PIPELINE_TRACE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Optional per-item latency tracing. A tracer is attached to the input sides
+ * of a pipeline; every sample_interval-th item entering a traced input side
+ * without a context receives a trace_context. The context travels with the
+ * item through input_side::take(), the thread that took it and the next
+ * output_side::output() call, so stages do not need to know about tracing.
+ *
+ * The context is not stored with the item itself: output() picks up whatever
+ * item the calling thread took last. Only stages which produce exactly one
+ * output per input, in the order they took them, are traced correctly. A
+ * stage which batches, reorders, fans out or outputs from a different thread
+ * than the one which took the item attributes its outputs to the wrong (or no)
+ * context, and its processing times are off accordingly.
+ *
+ * For every hop the tracer records
+ *      queueing:   time between input() and take()
+ *      processing: time between take() and the next output() (or take()) on the same thread
+ *      end_to_end: time between the first traced input() and take() at this hop
+ */
+
+namespace glados
+{
+    namespace pipeline
+    {
+        using trace_clock = std::chrono::steady_clock;
+
+        struct trace_context
+        {
+            std::uint64_t id = 0;
+            bool sampled = false;
+            trace_clock::time_point origin;
+            trace_clock::time_point enqueued;
+        };
+
+        struct latency_summary
+        {
+            std::size_t samples = 0;
+            trace_clock::duration p50 = trace_clock::duration::zero();
+            trace_clock::duration p90 = trace_clock::duration::zero();
+            trace_clock::duration p99 = trace_clock::duration::zero();
+            trace_clock::duration max = trace_clock::duration::zero();
+        };
+
+        struct hop_report
+        {
+            std::string name;
+            latency_summary queueing;
+            latency_summary processing;
+            latency_summary end_to_end;
+        };
+
+        class tracer;
+
+        namespace detail
+        {
+            class latency_samples
+            {
+                public:
+                    explicit latency_samples(std::size_t capacity)
+                    : capacity_{std::max(std::size_t{1}, capacity)}, next_{0}
+                    {
+                        samples_.reserve(capacity_);
+                    }
+
+                    /* keeps the most recent samples only */
+                    auto add(trace_clock::duration d) -> void
+                    {
+                        if(samples_.size() < capacity_)
+                            samples_.push_back(d);
+                        else
+                            samples_[next_] = d;
+
+                        next_ = (next_ + 1) % capacity_;
+                    }
+
+                    auto summarize() const -> latency_summary
+                    {
+                        auto s = latency_summary{};
+                        if(samples_.empty())
+                            return s;
+
+                        auto sorted = samples_;
+                        std::sort(std::begin(sorted), std::end(sorted));
+
+                        auto at = [&sorted](double q)
+                        {
+                            auto idx = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+                            return sorted[idx];
+                        };
+
+                        s.samples = sorted.size();
+                        s.p50 = at(0.5);
+                        s.p90 = at(0.9);
+                        s.p99 = at(0.99);
+                        s.max = sorted.back();
+                        return s;
+                    }
+
+                private:
+                    std::size_t capacity_;
+                    std::size_t next_;
+                    std::vector<trace_clock::duration> samples_;
+            };
+        }
+
+        class trace_hop : public std::enable_shared_from_this<trace_hop>
+        {
+            public:
+                trace_hop(tracer* owner, std::string name, std::size_t max_samples)
+                : owner_{owner}, name_{std::move(name)}
+                , queueing_{max_samples}, processing_{max_samples}, end_to_end_{max_samples}
+                {}
+
+                auto owner() const noexcept -> tracer* { return owner_; }
+
+                auto record_take(const trace_context& ctx, trace_clock::time_point now) -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    queueing_.add(now - ctx.enqueued);
+                    end_to_end_.add(now - ctx.origin);
+                }
+
+                auto record_processing(trace_clock::duration d) -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    processing_.add(d);
+                }
+
+                auto report() const -> hop_report
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    return hop_report{name_, queueing_.summarize(), processing_.summarize(), end_to_end_.summarize()};
+                }
+
+            private:
+                tracer* owner_;
+                std::string name_;
+                mutable std::mutex mutex_;
+                detail::latency_samples queueing_;
+                detail::latency_samples processing_;
+                detail::latency_samples end_to_end_;
+        };
+
+        class tracer
+        {
+            public:
+                /* every sample_interval-th item is traced; at most max_samples values are kept per hop and metric */
+                explicit tracer(std::size_t sample_interval = 64, std::size_t max_samples = 4096)
+                : interval_{std::max(std::size_t{1}, sample_interval)}, max_samples_{max_samples}, next_id_{0}
+                {}
+
+                tracer(const tracer&) = delete;
+                auto operator=(const tracer&) -> tracer& = delete;
+
+                /*
+                 * Side is an input_side or a stage; it must not hold items yet and the
+                 * tracer has to outlive its use
+                 */
+                template <class Side>
+                auto attach(Side& side, std::string name) -> void
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    hops_.push_back(std::make_shared<trace_hop>(this, std::move(name), max_samples_));
+                    try
+                    {
+                        side.set_trace_hop(hops_.back().get());
+                    }
+                    catch(...)
+                    {
+                        hops_.pop_back();
+                        throw;
+                    }
+                }
+
+                auto report() const -> std::vector<hop_report>
+                {
+                    auto&& lock = std::lock_guard<std::mutex>{mutex_};
+                    auto ret = std::vector<hop_report>{};
+                    for(auto&& h : hops_)
+                        ret.push_back(h->report());
+                    return ret;
+                }
+
+                auto new_context(trace_clock::time_point now) noexcept -> trace_context
+                {
+                    auto ctx = trace_context{};
+                    ctx.id = next_id_++;
+                    ctx.sampled = (ctx.id % interval_) == 0;
+                    ctx.origin = now;
+                    return ctx;
+                }
+
+            private:
+                std::size_t interval_;
+                std::size_t max_samples_;
+                std::atomic<std::uint64_t> next_id_;
+                mutable std::mutex mutex_;
+                std::vector<std::shared_ptr<trace_hop>> hops_;
+        };
+
+        namespace detail
+        {
+            /*
+             * The context of the item the current thread took last, which is only the
+             * context of the item being output for 1:1 in-order stages. Threads outlive
+             * pipelines and tracers, so the hop is only referenced weakly.
+             */
+            struct thread_trace
+            {
+                trace_context ctx;
+                std::weak_ptr<trace_hop> hop;
+                trace_clock::time_point taken;
+                bool pending = false; // processing time not yet recorded
+            };
+
+            inline auto current_trace() noexcept -> thread_trace&
+            {
+                thread_local auto t = thread_trace{};
+                return t;
+            }
+
+            inline auto finish_processing(trace_clock::time_point now) -> void
+            {
+                auto& t = current_trace();
+                if(t.pending)
+                {
+                    if(auto hop = t.hop.lock())
+                        hop->record_processing(now - t.taken);
+                    t.pending = false;
+                }
+            }
+
+            /* called by output_side before the item is handed to the next input side */
+            inline auto trace_output() -> void
+            {
+                auto& t = current_trace();
+                if(t.pending)
+                    finish_processing(trace_clock::now());
+            }
+
+            /* called by input_side::input(): propagates the current context or starts a new one */
+            inline auto trace_input(trace_hop* dest) -> trace_context
+            {
+                auto now = trace_clock::now();
+                auto& t = current_trace();
+
+                auto hop = t.hop.lock();
+                auto ctx = (hop != nullptr && hop->owner() == dest->owner()) ? t.ctx : dest->owner()->new_context(now);
+                ctx.enqueued = now;
+                return ctx;
+            }
+
+            /* called by input_side::take() */
+            inline auto trace_take(trace_hop* hop, const trace_context& ctx) -> void
+            {
+                auto now = trace_clock::now();
+                finish_processing(now);
+
+                auto& t = current_trace();
+                t.ctx = ctx;
+                t.hop = hop->shared_from_this();
+                t.taken = now;
+                t.pending = ctx.sampled;
+
+                if(ctx.sampled)
+                    hop->record_take(ctx, now);
+            }
+        }
+    }
+}
+
+#endif /* GLADOS_PIPELINE_TRACE_H_ */
@@ -167,3 +167,67 @@ BOOST_AUTO_TEST_CASE(cuda_copy_async_3d)
 
     BOOST_CHECK(std::equal(ho, ho + dim, hd));
 }
+
+BOOST_AUTO_TEST_CASE(cuda_copy_sync_pitched_host_2d)
+{
+    constexpr auto szx = 1024;
+    constexpr auto szy = 16;
+    constexpr auto dim = szx * szy;
+
+    auto host_orig = glados::cuda::make_unique_pinned_host<int>(szx, szy);
+    auto host_dest = glados::cuda::make_unique_pinned_host<int>(szx, szy);
+    auto pitched = glados::cuda::make_unique_pitched_host<int>(szx, szy);
+    auto dev = glados::cuda::make_unique_device<int>(szx, szy);
+
+    // power-of-two rows are padded by one cache line
+    BOOST_CHECK_EQUAL(pitched.pitch(), szx * sizeof(int) + 64);
+
+    auto ho = host_orig.get();
+    auto hd = host_dest.get();
+
+    std::generate(ho, ho + dim, std::rand);
+    std::fill(hd, hd + dim, 0);
+
+    glados::cuda::copy(glados::cuda::sync, pitched, host_orig, szx, szy);
+    glados::cuda::copy(glados::cuda::sync, dev, pitched, szx, szy);
+    glados::cuda::copy(glados::cuda::sync, host_dest, dev, szx, szy);
+
+    BOOST_CHECK(std::equal(ho, ho + dim, hd));
+}
+
+BOOST_AUTO_TEST_CASE(cuda_copy_sync_view_3d)
+{
+    constexpr auto szx = 16;
+    constexpr auto szy = 8;
+    constexpr auto szz = 8;
+    constexpr auto dim = szx * szy * szz;
+
+    auto host_orig = glados::cuda::make_unique_pinned_host<int>(szx, szy, szz);
+    auto host_dest = glados::cuda::make_unique_pinned_host<int>(4, 2, 3);
+    auto dev = glados::cuda::make_unique_device<int>(szx, szy, szz);
+
+    auto ho = host_orig.get();
+    std::generate(ho, ho + dim, std::rand);
+    std::fill(host_dest.get(), host_dest.get() + 4 * 2 * 3, 0);
+
+    // copy a 4x2x3 window through views instead of offsets
+    auto src = glados::make_view(host_orig, szx, szy, szz).subview(2, 3, 1, 4, 2, 3);
+    auto roi = glados::make_view(dev, szx, szy, szz).subview(5, 1, 4, 4, 2, 3);
+    auto dst = glados::make_view(host_dest, 4, 2, 3);
+
+    glados::cuda::copy(glados::cuda::sync, roi, src, 4, 2, 3);
+    glados::cuda::copy(glados::cuda::sync, dst, roi, 4, 2, 3);
+
+    for(auto z = 0; z < 3; ++z)
+        for(auto y = 0; y < 2; ++y)
+            for(auto x = 0; x < 4; ++x)
+                BOOST_CHECK_EQUAL(dst(x, y, z), src(x, y, z));
+
+    // a single slice is a 2D view
+    auto plane = src.slice(2);
+    auto dst_plane = dst.slice(2);
+    std::fill(host_dest.get(), host_dest.get() + 4 * 2 * 3, 0);
+    glados::cuda::copy(glados::cuda::sync, dst_plane, plane, 4, 2);
+    BOOST_CHECK_EQUAL(dst(3, 1, 2), ho[(3 * szy + 4) * szx + 5]);
+    BOOST_CHECK_EQUAL(dst(3, 1, 1), 0);
+}
@@ -185,3 +185,22 @@ BOOST_AUTO_TEST_CASE(cuda_fill_async_3d)
 
     BOOST_CHECK(std::equal(ho, ho + dim, hd));
 }
+
+BOOST_AUTO_TEST_CASE(cuda_fill_sync_pitched_host_3d)
+{
+    constexpr auto szx = 256;
+    constexpr auto szy = 8;
+    constexpr auto szz = 8;
+    constexpr auto dim = szx * szy * szz;
+
+    auto pitched = glados::cuda::make_unique_pitched_host<int>(szx, szy, szz);
+    auto host_dest = glados::cuda::make_unique_pinned_host<int>(szx, szy, szz);
+
+    auto hd = host_dest.get();
+    std::generate(hd, hd + dim, std::rand);
+
+    glados::cuda::fill(glados::cuda::sync, pitched, 7, szx, szy, szz);
+    glados::cuda::copy(glados::cuda::sync, host_dest, pitched, szx, szy, szz);
+
+    BOOST_CHECK(std::all_of(hd, hd + dim, [](int v) { return v == 7; }));
+}
@@ -0,0 +1,444 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE HostAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/allocator.h>
+#include <glados/generic/arena_allocator.h>
+#include <glados/generic/bricked_allocator.h>
+#include <glados/generic/file_allocator.h>
+#include <glados/generic/hugepage_allocator.h>
+#include <glados/memory.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_CASE(hugepage_alloc_small_and_large)
+{
+    auto small = glados::generic::hugepage_allocator<float, glados::memory_layout::pointer_1D>{};
+    auto p = small.allocate(100);
+    BOOST_CHECK(glados::generic::backing_of(p) == glados::generic::page_backing::small);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % 64, 0u);
+    p[0] = 1.f;
+    p[99] = 2.f;
+    small.deallocate(p);
+
+    // 3 * 2 MiB, the backing depends on the system's huge page configuration
+    auto large = glados::generic::hugepage_allocator<float, glados::memory_layout::pointer_3D>{};
+    auto q = large.allocate(512, 512, 6);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(q) % (std::size_t{2} << 20), 0u);
+    BOOST_CHECK_EQUAL(glados::generic::detail::mapped_bytes(q), std::size_t{6} << 20);
+    BOOST_CHECK_EQUAL(q[0], 0.f);
+    q[0] = 1.f;
+    q[512 * 512 * 6 - 1] = 2.f;
+    BOOST_CHECK_EQUAL(q[512 * 512 * 6 - 1], 2.f);
+    large.deallocate(q);
+
+    // sizes which do not fit into std::size_t must not wrap around to a small mapping
+    auto huge = std::numeric_limits<std::size_t>::max();
+    BOOST_CHECK_THROW(large.allocate(huge / 2, 2, 1), std::bad_array_new_length);
+    BOOST_CHECK_THROW(small.allocate(huge / 2), std::bad_array_new_length);
+}
+
+BOOST_AUTO_TEST_CASE(hugepage_alloc_as_pool_backend)
+{
+    using internal = glados::generic::hugepage_allocator<float, glados::memory_layout::pointer_2D>;
+    auto pool = glados::pool_allocator<float, glados::memory_layout::pointer_2D, internal>{};
+
+    auto a = pool.allocate(1024, 1024);
+    a[1024 * 1024 - 1] = 3.f;
+    pool.deallocate(a);
+    BOOST_CHECK_EQUAL(pool.allocate(1024, 1024), a);
+    pool.deallocate(a);
+    pool.release();
+}
+
+BOOST_AUTO_TEST_CASE(arena_alloc_bump_and_reset)
+{
+    auto a = glados::generic::arena{1024, 64};
+    auto alloc1 = glados::generic::arena_allocator<float, glados::memory_layout::pointer_1D>{a};
+    auto alloc2 = glados::generic::arena_allocator<double, glados::memory_layout::pointer_2D>{a};
+
+    auto p = alloc1.allocate(10);
+    auto q = alloc2.allocate(4, 4);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % 64, 0u);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(q) % 64, 0u);
+    BOOST_CHECK(static_cast<void*>(p + 10) <= static_cast<void*>(q));
+    BOOST_CHECK_EQUAL(a.used(), 10 * sizeof(float) + 16 * sizeof(double));
+    BOOST_CHECK_EQUAL(a.capacity(), 1024u);
+
+    // larger than a block: gets a block of its own which reset() drops again
+    auto big = glados::generic::arena_allocator<char, glados::memory_layout::pointer_3D>{a}.allocate(16, 16, 16);
+    big[16 * 16 * 16 - 1] = 'x';
+    BOOST_CHECK_GT(a.capacity(), 1024u + 4096u);
+
+    a.reset();
+    BOOST_CHECK_EQUAL(a.used(), 0u);
+    BOOST_CHECK_EQUAL(a.capacity(), 1024u);
+    BOOST_CHECK_EQUAL(alloc1.allocate(10), p);
+
+    a.release();
+    BOOST_CHECK_EQUAL(a.capacity(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(arena_alloc_thread_arena_scope)
+{
+    auto alloc = glados::generic::arena_allocator<int, glados::memory_layout::pointer_1D>{};
+    BOOST_CHECK_EQUAL(alloc.get_arena(), &glados::generic::thread_arena());
+    {
+        glados::generic::arena_scope scope{};
+        auto p = alloc.allocate(100);
+        p[99] = 1;
+        BOOST_CHECK_GE(glados::generic::thread_arena().used(), 100 * sizeof(int));
+    }
+    BOOST_CHECK_EQUAL(glados::generic::thread_arena().used(), 0u);
+
+    // a default-constructed allocator follows the thread calling allocate()
+    auto other = static_cast<glados::generic::arena*>(nullptr);
+    auto worker = std::thread{[&alloc, &other]()
+    {
+        alloc.allocate(10);
+        other = alloc.get_arena();
+    }};
+    worker.join();
+    BOOST_CHECK(other != &glados::generic::thread_arena());
+    BOOST_CHECK_EQUAL(glados::generic::thread_arena().used(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(arena_alloc_overflow)
+{
+    auto a = glados::generic::arena{1024, 64};
+    auto huge = std::numeric_limits<std::size_t>::max();
+    BOOST_CHECK_THROW(a.allocate(huge), std::bad_array_new_length);
+
+    auto alloc = glados::generic::arena_allocator<double, glados::memory_layout::pointer_3D>{a};
+    BOOST_CHECK_THROW(alloc.allocate(huge / 2, 2, 2), std::bad_array_new_length);
+    BOOST_CHECK_THROW(alloc.allocate(huge / 4, 1, 1), std::bad_array_new_length);
+    BOOST_CHECK_EQUAL(a.used(), 0u);
+}
+
+namespace
+{
+    struct alignas(128) wide
+    {
+        float v[32];
+    };
+}
+
+BOOST_AUTO_TEST_CASE(generic_alloc_alignment)
+{
+    using float_alloc = glados::generic::allocator<float, glados::memory_layout::pointer_3D>;
+    using wide_alloc = glados::generic::allocator<wide, glados::memory_layout::pointer_1D>;
+    using string_alloc = glados::generic::allocator<std::string, glados::memory_layout::pointer_1D>;
+    static_assert(float_alloc::alignment == 64, "trivial types are cache line aligned");
+    static_assert(wide_alloc::alignment == 128, "over-aligned types keep their alignment");
+    static_assert(string_alloc::alignment == alignof(std::string), "other types use new T[]");
+
+    auto a = float_alloc{};
+    auto p = a.allocate(3, 5, 7);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % 64, 0u);
+    p[3 * 5 * 7 - 1] = 1.f;
+    a.deallocate(p);
+
+    auto w = wide_alloc{};
+    auto q = w.allocate(3);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(q) % 128, 0u);
+    w.deallocate(q);
+
+    auto s = string_alloc{};
+    auto r = s.allocate(2);
+    BOOST_CHECK(r[0].empty());
+    r[1] = "constructed";
+    s.deallocate(r);
+
+    // extents whose product overflows fail like new T[n] instead of wrapping around
+    auto huge = std::size_t{1} << (sizeof(std::size_t) * 4);
+    BOOST_CHECK_THROW(a.allocate(huge, huge, 2), std::bad_array_new_length);
+    auto f = glados::generic::allocator<float, glados::memory_layout::pointer_1D>{};
+    BOOST_CHECK_THROW(f.allocate(huge * (huge / 2)), std::bad_array_new_length);
+}
+
+BOOST_AUTO_TEST_CASE(file_alloc_successive_windows)
+{
+    char path[] = "/tmp/glados_file_allocXXXXXX";
+    auto fd = ::mkstemp(path);
+    BOOST_REQUIRE(fd != -1);
+
+    // three 5x3 float projections
+    auto values = std::vector<float>(45);
+    for(auto i = std::size_t{0}; i < values.size(); ++i)
+        values[i] = static_cast<float>(i);
+    BOOST_REQUIRE_EQUAL(::write(fd, values.data(), values.size() * sizeof(float)), static_cast<ssize_t>(values.size() * sizeof(float)));
+    ::close(fd);
+
+    {
+        auto options = glados::generic::mapping_options{};
+        options.populate = true;
+        options.writable = true;
+        glados::generic::mapped_file file{path, options};
+        BOOST_CHECK_EQUAL(file.size(), 45 * sizeof(float));
+
+        auto alloc = glados::generic::file_allocator<float, glados::memory_layout::pointer_2D>{file};
+        auto first = alloc.allocate(5, 3);
+        auto second = alloc.allocate(5, 3);
+        BOOST_CHECK_EQUAL(first[0], 0.f);
+        BOOST_CHECK_EQUAL(second[0], 15.f);
+        BOOST_CHECK_EQUAL(second[14], 29.f);
+
+        // private mappings can be written without touching the file
+        second[0] = -1.f;
+        alloc.deallocate(second);
+        alloc.deallocate(first);
+
+        auto third = alloc.allocate(5, 3);
+        BOOST_CHECK_EQUAL(third[14], 44.f);
+        BOOST_CHECK_THROW(alloc.allocate(5, 3), std::out_of_range);
+
+        file.seek(15 * sizeof(float));
+        auto again = std::unique_ptr<float[], glados::generic::mapped_deleter>{alloc.allocate(5, 3), glados::generic::mapped_deleter{&file}};
+        BOOST_CHECK_EQUAL(again[0], 15.f);
+    }
+
+    ::unlink(path);
+}
+
+namespace
+{
+    /* Anonymous kB of the mapping containing p, taken from /proc/self/smaps */
+    auto anonymous_kb(const void* p) -> long
+    {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        auto smaps = std::ifstream{"/proc/self/smaps"};
+        auto line = std::string{};
+        auto inside = false;
+        while(std::getline(smaps, line))
+        {
+            auto begin = std::uintptr_t{};
+            auto end = std::uintptr_t{};
+            if(std::sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR, &begin, &end) == 2 && line.find(':') > line.find(' '))
+                inside = begin <= addr && addr < end;
+            else if(inside && line.compare(0, 10, "Anonymous:") == 0)
+                return std::stol(line.substr(10));
+        }
+        return -1;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(file_alloc_populate_without_copies)
+{
+    char path[] = "/tmp/glados_file_allocXXXXXX";
+    auto fd = ::mkstemp(path);
+    BOOST_REQUIRE(fd != -1);
+
+    constexpr auto bytes = std::size_t{4} << 20;
+    auto data = std::vector<char>(bytes, 'g');
+    BOOST_REQUIRE_EQUAL(::write(fd, data.data(), bytes), static_cast<ssize_t>(bytes));
+    ::close(fd);
+
+    {
+        // populated windows come straight from the page cache, writable or not
+        auto options = glados::generic::mapping_options{};
+        options.populate = true;
+        glados::generic::mapped_file read_only{path, options};
+        auto p = static_cast<const char*>(read_only.map(0, bytes));
+        BOOST_CHECK_EQUAL(p[bytes - 1], 'g');
+        BOOST_CHECK_EQUAL(anonymous_kb(p), 0);
+
+        options.writable = true;
+        glados::generic::mapped_file writable{path, options};
+        auto q = static_cast<char*>(writable.map(0, bytes));
+        BOOST_CHECK_EQUAL(anonymous_kb(q), 0);
+
+        // only written pages are copied
+        q[0] = 'w';
+        BOOST_CHECK_LE(anonymous_kb(q), 64);
+        BOOST_CHECK_EQUAL(p[0], 'g');
+    }
+
+    ::unlink(path);
+}
+
+BOOST_AUTO_TEST_CASE(file_alloc_concurrent_windows)
+{
+    char path[] = "/tmp/glados_file_allocXXXXXX";
+    auto fd = ::mkstemp(path);
+    BOOST_REQUIRE(fd != -1);
+
+    constexpr auto windows = 64;
+    constexpr auto window = std::size_t{4096};
+    BOOST_REQUIRE_EQUAL(::ftruncate(fd, windows * window), 0);
+    ::close(fd);
+
+    {
+        glados::generic::mapped_file file{path};
+
+        // an offset close to SIZE_MAX must not wrap around the bounds check
+        BOOST_CHECK_THROW(file.map(SIZE_MAX, 2), std::out_of_range);
+        BOOST_CHECK_THROW(file.map(file.size(), 1), std::out_of_range);
+
+        // every window is handed out exactly once, end of file only once all are gone
+        std::mutex m;
+        std::atomic<int> spurious{0};
+        auto taken = std::vector<void*>{};
+        auto threads = std::vector<std::thread>{};
+        for(auto t = 0; t < 8; ++t)
+        {
+            threads.emplace_back([&]()
+            {
+                while(true)
+                {
+                    try
+                    {
+                        auto p = file.map_next(window);
+                        auto&& lock = std::lock_guard<std::mutex>{m};
+                        taken.push_back(p);
+                    }
+                    catch(const std::out_of_range&)
+                    {
+                        if(file.tell() != file.size())
+                            ++spurious;
+                        return;
+                    }
+                }
+            });
+        }
+        for(auto&& t : threads)
+            t.join();
+
+        BOOST_CHECK_EQUAL(spurious.load(), 0);
+        BOOST_CHECK_EQUAL(taken.size(), std::size_t{windows});
+        BOOST_CHECK_EQUAL(file.tell(), file.size());
+        for(auto&& p : taken)
+            file.unmap(p);
+    }
+
+    ::unlink(path);
+}
+
+BOOST_AUTO_TEST_CASE(bricked_alloc_round_trip)
+{
+    constexpr auto x = std::size_t{13};
+    constexpr auto y = std::size_t{9};
+    constexpr auto z = std::size_t{17};
+
+    auto linear = std::vector<int>(x * y * z);
+    for(auto i = std::size_t{0}; i < linear.size(); ++i)
+        linear[i] = static_cast<int>(i);
+
+    auto check = [&](auto alloc)
+    {
+        using alloc_type = decltype(alloc);
+        static_assert(alloc_type::mem_layout == glados::memory_layout::bricked_3D, "Wrong layout");
+
+        auto p = alloc.allocate(x, y, z);
+        auto v = alloc_type::view(p, x, y, z);
+        BOOST_CHECK_EQUAL(v.layout().size(), std::size_t{2 * 2 * 3 * 512});
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % alloc_type::alignment, std::uintptr_t{0});
+
+        glados::copy_to_bricked(v, linear.data());
+        for(auto k = std::size_t{0}; k < z; ++k)
+            for(auto j = std::size_t{0}; j < y; ++j)
+                for(auto i = std::size_t{0}; i < x; ++i)
+                    BOOST_CHECK_EQUAL(v(i, j, k), linear[(k * y + j) * x + i]);
+
+        // write back into a pitched destination
+        auto pitch = (x + 3) * sizeof(int);
+        auto back = std::vector<int>((x + 3) * y * z, -1);
+        glados::copy_to_linear(back.data(), pitch, glados::bricked_view<const int, 8, alloc_type::layout_type::order>{v});
+        for(auto k = std::size_t{0}; k < z; ++k)
+            for(auto j = std::size_t{0}; j < y; ++j)
+            {
+                for(auto i = std::size_t{0}; i < x; ++i)
+                    BOOST_CHECK_EQUAL(back[(k * y + j) * (x + 3) + i], linear[(k * y + j) * x + i]);
+                BOOST_CHECK_EQUAL(back[(k * y + j) * (x + 3) + x], -1);
+            }
+
+        alloc.deallocate(p);
+    };
+
+    check(glados::generic::bricked_allocator<int>{});
+    check(glados::generic::bricked_allocator<int, 8, glados::brick_order::morton>{});
+
+    // inside a Z-ordered brick the eight corners of a 2x2x2 cube are contiguous
+    auto l = glados::bricked_layout<8, glados::brick_order::morton>{8, 8, 8};
+    BOOST_CHECK_EQUAL(l.index(1, 0, 0), std::size_t{1});
+    BOOST_CHECK_EQUAL(l.index(0, 1, 0), std::size_t{2});
+    BOOST_CHECK_EQUAL(l.index(1, 1, 1), std::size_t{7});
+    BOOST_CHECK_EQUAL(l.index(7, 7, 7), std::size_t{511});
+}
+
+BOOST_AUTO_TEST_CASE(strided_view_windows)
+{
+    constexpr auto x = std::size_t{10};
+    constexpr auto y = std::size_t{6};
+    constexpr auto z = std::size_t{4};
+
+    using alloc_type = glados::generic::allocator<int, glados::memory_layout::pointer_3D>;
+    auto buf = std::unique_ptr<int[], glados::generic::deleter<int>>{alloc_type{}.allocate(x, y, z)};
+    for(auto i = std::size_t{0}; i < x * y * z; ++i)
+        buf[i] = static_cast<int>(i);
+
+    auto v = glados::make_view(buf, x, y, z);
+    static_assert(decltype(v)::pitched_memory && decltype(v)::mem_location == glados::memory_location::host, "Wrong view traits");
+    BOOST_CHECK_EQUAL(v.pitch(), x * sizeof(int));
+    BOOST_CHECK_EQUAL(v(3, 2, 1), static_cast<int>((1 * y + 2) * x + 3));
+
+    // windows keep the pitch and slice distance of the parent buffer
+    auto roi = v.subview(2, 1, 1, 5, 3, 2);
+    BOOST_CHECK_EQUAL(roi.x(), std::size_t{5});
+    BOOST_CHECK_EQUAL(roi.rows(), y);
+    BOOST_CHECK_EQUAL(roi(0, 0, 0), v(2, 1, 1));
+    BOOST_CHECK_EQUAL(roi(4, 2, 1), v(6, 3, 2));
+
+    auto plane = roi.slice(1);
+    static_assert(decltype(plane)::rank == 2, "Slices are 2D");
+    BOOST_CHECK_EQUAL(plane(1, 2), v(3, 3, 2));
+
+    auto line = plane.row(1);
+    static_assert(!decltype(line)::pitched_memory, "Rows are contiguous");
+    BOOST_CHECK_EQUAL(line.pitch(), std::size_t{0});
+    BOOST_CHECK_EQUAL(line(4), v(6, 2, 2));
+
+    // writes go to the underlying buffer
+    line(0) = -1;
+    BOOST_CHECK_EQUAL(buf[(2 * y + 2) * x + 2], -1);
+
+    auto cv = glados::strided_view<const int, 3, glados::memory_location::host>{roi};
+    BOOST_CHECK_EQUAL(cv(0, 0, 0), roi(0, 0, 0));
+}
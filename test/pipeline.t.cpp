@@ -0,0 +1,171 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#define BOOST_TEST_MODULE Pipeline
+#include <boost/test/unit_test.hpp>
+
+#include <glados/pipeline/pipeline.h>
+
+namespace
+{
+    struct item
+    {
+        int value;
+        bool valid;
+    };
+
+    class source
+    {
+        public:
+            using input_type = void;
+            using output_type = item;
+
+            auto run() -> void
+            {
+                for(auto i = 0; i < 256; ++i)
+                    output_(item{i, true});
+                output_(item{0, false});
+            }
+
+            auto set_output_function(std::function<void(output_type)> f) noexcept -> void { output_ = f; }
+
+        private:
+            std::function<void(output_type)> output_;
+    };
+
+    class worker
+    {
+        public:
+            using input_type = item;
+            using output_type = item;
+
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto i = input_();
+                    if(i.valid)
+                        std::this_thread::sleep_for(std::chrono::microseconds{200});
+
+                    auto valid = i.valid;
+                    output_(std::move(i));
+                    if(!valid)
+                        break;
+                }
+            }
+
+            auto set_input_function(std::function<input_type(void)> f) noexcept -> void { input_ = f; }
+            auto set_output_function(std::function<void(output_type)> f) noexcept -> void { output_ = f; }
+
+        private:
+            std::function<input_type(void)> input_;
+            std::function<void(output_type)> output_;
+    };
+
+    class sink
+    {
+        public:
+            using input_type = item;
+            using output_type = void;
+
+            auto run() -> void
+            {
+                while(input_().valid)
+                    ++count;
+            }
+
+            auto set_input_function(std::function<input_type(void)> f) noexcept -> void { input_ = f; }
+
+            int count = 0;
+
+        private:
+            std::function<input_type(void)> input_;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_latency_tracing)
+{
+    auto p = glados::pipeline::pipeline{};
+    auto src = p.make_stage<source>();
+    auto wrk = p.make_stage<worker>();
+    auto snk = p.make_stage<sink>();
+
+    glados::pipeline::tracer t{8};
+    p.trace(t, src, wrk, snk);
+    p.connect(src, wrk, snk);
+    p.run(src, wrk, snk);
+    p.wait();
+
+    BOOST_CHECK_EQUAL(snk.count, 256);
+
+    auto r = t.report();
+    BOOST_REQUIRE_EQUAL(r.size(), 2u);
+    BOOST_CHECK_EQUAL(r[0].name, "stage 1");
+    BOOST_CHECK_EQUAL(r[1].name, "stage 2");
+
+    // item 0 and every 8th item after it are sampled
+    BOOST_CHECK_EQUAL(r[0].queueing.samples, 33u);
+    BOOST_CHECK_EQUAL(r[1].queueing.samples, 33u);
+    BOOST_CHECK(r[0].processing.samples >= 32u);
+    BOOST_CHECK(r[0].processing.p50 >= std::chrono::microseconds{200});
+    BOOST_CHECK(r[1].end_to_end.p50 >= r[0].end_to_end.p50);
+    BOOST_CHECK(r[1].end_to_end.max >= r[1].end_to_end.p99);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_tracing_outlived_by_threads)
+{
+    // the main thread takes a traced item, then the tracer and the side go away
+    {
+        glados::pipeline::tracer t{1};
+        glados::pipeline::input_side<item> in;
+        t.attach(in, "first");
+        in.input(item{1, true});
+        in.take();
+    }
+
+    // a later pipeline on the same thread must not touch the destroyed hop
+    glados::pipeline::tracer t{1};
+    glados::pipeline::input_side<item> in;
+    t.attach(in, "second");
+    in.input(item{2, true});
+    BOOST_CHECK_EQUAL(in.take().value, 2);
+    in.input(item{3, true});
+    in.take();
+
+    auto r = t.report();
+    BOOST_REQUIRE_EQUAL(r.size(), 1u);
+    BOOST_CHECK_EQUAL(r[0].queueing.samples, 2u);
+
+    // tracing cannot start while items without a context are queued
+    glados::pipeline::input_side<item> busy;
+    busy.input(item{4, true});
+    BOOST_CHECK_THROW(t.attach(busy, "late"), std::logic_error);
+    BOOST_CHECK_EQUAL(t.report().size(), 1u);
+    BOOST_CHECK(!busy.traced());
+}
@@ -0,0 +1,582 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE PoolAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <glados/generic/allocator.h>
+#include <glados/generic/file_allocator.h>
+#include <glados/memory.h>
+#include <glados/pipeline/input_side.h>
+
+namespace
+{
+    template <glados::memory_layout ml>
+    using host_pool = glados::pool_allocator<int, ml, glados::generic::allocator<int, ml>>;
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_reuses_buffers)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_1D>{};
+
+    auto a = alloc.allocate(64);
+    auto b = alloc.allocate(64);
+    BOOST_CHECK(a != b);
+
+    alloc.deallocate(b);
+    alloc.deallocate(a);
+
+    // most recently returned buffer first
+    BOOST_CHECK_EQUAL(alloc.allocate(64), a);
+    BOOST_CHECK_EQUAL(alloc.allocate(64), b);
+
+    alloc.deallocate(a);
+    alloc.deallocate(b);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_concurrent_recycling)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_2D>{};
+    alloc.deallocate(alloc.allocate(8, 8));
+
+    constexpr auto threads = 8;
+    constexpr auto rounds = 20000;
+
+    // Boost.Test assertions are not thread-safe
+    std::atomic<int> errors{0};
+
+    auto workers = std::vector<std::thread>{};
+    for(auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&alloc, &errors, t]()
+        {
+            for(auto i = 0; i < rounds; ++i)
+            {
+                auto p = alloc.allocate(8, 8);
+                auto q = alloc.allocate(8, 8);
+
+                // a buffer must never be handed out twice at the same time
+                p[0] = t;
+                q[0] = t;
+                if(p == q || p[0] != t)
+                    ++errors;
+
+                alloc.deallocate(q);
+                alloc.deallocate(p);
+            }
+        });
+    }
+
+    for(auto&& w : workers)
+        w.join();
+    BOOST_CHECK_EQUAL(errors.load(), 0);
+
+    // at most two buffers per thread were in flight
+    auto seen = std::set<int*>{};
+    auto held = std::vector<int*>{};
+    for(auto i = 0; i < 2 * threads; ++i)
+    {
+        held.push_back(alloc.allocate(8, 8));
+        seen.insert(held.back());
+    }
+    BOOST_CHECK_EQUAL(seen.size(), held.size());
+
+    for(auto p : held)
+        alloc.deallocate(p);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_move_and_smart)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_3D>{4};
+    auto p = alloc.allocate(4, 4, 4);
+    alloc.deallocate(p);
+
+    auto moved = std::move(alloc);
+    BOOST_CHECK(alloc.allocate(4, 4, 4) == nullptr);
+
+    {
+        auto s = moved.allocate_smart(4, 4, 4);
+        BOOST_CHECK_EQUAL(s.get(), p);
+    }
+
+    BOOST_CHECK_EQUAL(moved.allocate(4, 4, 4), p);
+    moved.deallocate(p);
+    moved.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_buffers_move_between_threads)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_1D>{};
+
+    // more buffers than fit into one magazine, so some end up in the depot
+    constexpr auto count = 100;
+    auto buffers = std::vector<int*>{};
+    for(auto i = 0; i < count; ++i)
+        buffers.push_back(alloc.allocate(32));
+
+    std::thread{[&alloc, &buffers]()
+    {
+        for(auto p : buffers)
+            alloc.deallocate(p);
+    }}.join();
+
+    // another thread gets them back from the depot and the other magazine
+    auto reused = std::set<int*>{};
+    std::thread{[&alloc, &reused]()
+    {
+        for(auto i = 0; i < count; ++i)
+            reused.insert(alloc.allocate(32));
+    }}.join();
+
+    BOOST_CHECK((reused == std::set<int*>(std::begin(buffers), std::end(buffers))));
+
+    for(auto p : reused)
+        alloc.deallocate(p);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(size_class_pool_alloc_mixed_shapes)
+{
+    BOOST_CHECK_EQUAL(glados::detail::size_class(3), 3u);
+    BOOST_CHECK_EQUAL(glados::detail::size_class(64), 64u);
+    BOOST_CHECK_EQUAL(glados::detail::size_class(65), 80u);
+    BOOST_CHECK_EQUAL(glados::detail::size_class(1000), 1024u);
+    BOOST_CHECK_EQUAL(glados::detail::size_class(1025), 1280u);
+
+    using allocator_type = glados::generic::allocator<int, glados::memory_layout::pointer_2D>;
+    auto alloc = glados::size_class_pool_allocator<int, glados::memory_layout::pointer_2D, allocator_type>{};
+
+    auto projection = alloc.allocate(1000, 1000);
+    auto sinogram = alloc.allocate(1000, 720);
+    BOOST_CHECK(alloc.shape(projection) == (glados::pool_shape{1048576, 1, 1}));
+    BOOST_CHECK(alloc.shape(sinogram) == (glados::pool_shape{786432, 1, 1}));
+
+    alloc.deallocate(projection);
+    alloc.deallocate(sinogram);
+
+    // slightly different shapes share the size class
+    BOOST_CHECK_EQUAL(alloc.allocate(1024, 1000), projection);
+    BOOST_CHECK_EQUAL(alloc.allocate(720, 1000), sinogram);
+
+    // a different class gets a new buffer
+    auto slab = alloc.allocate(100, 100);
+    BOOST_CHECK(slab != projection && slab != sinogram);
+
+    alloc.deallocate(projection);
+    alloc.deallocate(sinogram);
+    alloc.deallocate(slab);
+    alloc.release();
+    BOOST_CHECK(alloc.shape(slab) == (glados::pool_shape{0, 0, 0}));
+
+    // a buffer from elsewhere is released by the internal allocator instead of leaking
+    auto foreign = allocator_type{}.allocate(16, 16);
+    alloc.deallocate(foreign, 16, 16);
+    BOOST_CHECK(alloc.shape(foreign) == (glados::pool_shape{0, 0, 0}));
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_blocking_and_timed)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_1D>{2};
+
+    auto a = alloc.allocate(16);
+    auto b = alloc.try_allocate(16);
+    BOOST_REQUIRE(b != nullptr);
+
+    BOOST_CHECK(alloc.try_allocate(16) == nullptr);
+    BOOST_CHECK(alloc.allocate_for(16, std::chrono::milliseconds{10}) == nullptr);
+
+    // a blocked allocate() is woken by deallocate()
+    auto c = static_cast<int*>(nullptr);
+    auto waiter = std::thread{[&alloc, &c]() { c = alloc.allocate(16); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    alloc.deallocate(a);
+    waiter.join();
+    BOOST_CHECK_EQUAL(c, a);
+
+    auto d = static_cast<int*>(nullptr);
+    auto timed = std::thread{[&alloc, &d]() { d = alloc.allocate_for(16, std::chrono::seconds{10}); }};
+    alloc.deallocate(b);
+    timed.join();
+    BOOST_CHECK_EQUAL(d, b);
+
+    alloc.deallocate(c);
+    alloc.deallocate(d);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_statistics)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_2D>{2};
+
+    auto a = alloc.allocate(16, 4);
+    auto b = alloc.allocate(16, 4);
+    alloc.deallocate(a);
+    auto c = alloc.allocate(16, 4);
+
+    auto s = alloc.statistics();
+    BOOST_CHECK_EQUAL(s.hits, 1u);
+    BOOST_CHECK_EQUAL(s.misses, 2u);
+    BOOST_CHECK_EQUAL(s.outstanding, 2u);
+    BOOST_CHECK_EQUAL(s.high_water, 2u);
+    BOOST_CHECK_EQUAL(s.idle_buffers, 0u);
+    BOOST_CHECK_EQUAL(s.waits, 0u);
+    BOOST_CHECK_CLOSE(s.hit_ratio(), 1.0 / 3.0, 0.01);
+
+    auto waiter = std::thread{[&alloc]() { alloc.deallocate(alloc.allocate(16, 4)); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    alloc.deallocate(b);
+    waiter.join();
+    alloc.deallocate(c);
+
+    s = alloc.statistics();
+    BOOST_CHECK_EQUAL(s.outstanding, 0u);
+    BOOST_CHECK_EQUAL(s.high_water, 2u);
+    BOOST_CHECK_EQUAL(s.idle_buffers, 2u);
+    BOOST_CHECK_EQUAL(s.idle_bytes, 2 * 16 * 4 * sizeof(int));
+    BOOST_CHECK_EQUAL(s.waits, 1u);
+    BOOST_CHECK(s.max_wait >= std::chrono::milliseconds{10});
+    BOOST_CHECK(s.total_wait >= s.max_wait);
+
+    alloc.release();
+    BOOST_CHECK_EQUAL(alloc.statistics().idle_buffers, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_reserve)
+{
+    auto alloc = host_pool<glados::memory_layout::pointer_3D>{};
+    alloc.reserve(4, 32, 32, 8, true);
+
+    auto s = alloc.statistics();
+    BOOST_CHECK_EQUAL(s.idle_buffers, 4u);
+    BOOST_CHECK_EQUAL(s.high_water, 4u);
+    BOOST_CHECK_EQUAL(s.misses, 0u);
+
+    // reserved buffers are served without creating new ones
+    auto held = std::vector<int*>{};
+    for(auto i = 0; i < 4; ++i)
+        held.push_back(alloc.allocate(32, 32, 8));
+
+    s = alloc.statistics();
+    BOOST_CHECK_EQUAL(s.hits, 4u);
+    BOOST_CHECK_EQUAL(s.misses, 0u);
+    BOOST_CHECK_EQUAL(s.outstanding, 4u);
+
+    // reserve() only tops up the idle buffers
+    alloc.reserve(2, 32, 32, 8);
+    BOOST_CHECK_EQUAL(alloc.statistics().idle_buffers, 2u);
+
+    for(auto p : held)
+        alloc.deallocate(p);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_trimming)
+{
+    auto policy = glados::pool_policy{};
+    policy.max_idle_buffers = 4;
+    policy.max_idle_age = std::chrono::milliseconds{20};
+    auto alloc = host_pool<glados::memory_layout::pointer_1D>{0, policy};
+
+    // a burst of 40 buffers
+    auto held = std::vector<int*>{};
+    for(auto i = 0; i < 40; ++i)
+        held.push_back(alloc.allocate(256));
+    for(auto p : held)
+        alloc.deallocate(p);
+
+    // overflowing magazines already shrank the depot
+    BOOST_CHECK_LT(alloc.statistics().idle_buffers, 40u);
+
+    alloc.trim();
+    BOOST_CHECK_EQUAL(alloc.statistics().idle_buffers, 4u);
+
+    // buffers which stay in the depot for a whole period are returned, too
+    alloc.reserve(8, 256);
+    std::this_thread::sleep_for(std::chrono::milliseconds{25});
+    alloc.trim();
+    std::this_thread::sleep_for(std::chrono::milliseconds{25});
+    alloc.trim();
+    BOOST_CHECK_LE(alloc.statistics().idle_buffers, 4u);
+
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_owning)
+{
+    auto policy = glados::pool_policy{};
+    policy.owning = true;
+
+    std::atomic<bool> returned{false};
+    auto worker = std::thread{};
+    {
+        auto alloc = host_pool<glados::memory_layout::pointer_2D>{0, policy};
+        auto p = alloc.allocate(8, 8);
+
+        // the destructor has to wait for this buffer
+        worker = std::thread{[&alloc, &returned, p]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{30});
+            returned = true;
+            alloc.deallocate(p);
+        }};
+    }
+    BOOST_CHECK(returned.load());
+    worker.join();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_wait_for_returns)
+{
+    auto policy = glados::pool_policy{};
+    policy.owning = true;
+    policy.close_timeout = std::chrono::seconds{5};
+
+    auto alloc = host_pool<glados::memory_layout::pointer_1D>{0, policy};
+    auto p = alloc.allocate(64);
+
+    // a buffer which is never returned must not block forever
+    BOOST_CHECK(!alloc.wait_for_returns(std::chrono::milliseconds{20}));
+
+    alloc.deallocate(p);
+    BOOST_CHECK(alloc.wait_for_returns(std::chrono::milliseconds{20}));
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_smart_pointer)
+{
+    using pool_type = host_pool<glados::memory_layout::pointer_2D>;
+    static_assert(std::is_same<pool_type::smart_pointer::deleter_type, glados::pool_deleter<int, pool_type>>::value,
+                  "pooled smart pointers must not use a type-erased deleter");
+
+    auto alloc = pool_type{};
+    auto raw = static_cast<int*>(nullptr);
+    {
+        auto p = alloc.allocate_smart(16, 8);
+        raw = p.get();
+
+        BOOST_CHECK_EQUAL(p.get_deleter().pool(), &alloc);
+        BOOST_CHECK_EQUAL(p.get_deleter().pitch(), 16 * sizeof(int));
+        BOOST_CHECK(p.get_deleter().extents() == (glados::pool_shape{16, 8, 1}));
+
+        auto moved = std::move(p);
+        BOOST_CHECK(p == nullptr);
+        BOOST_CHECK_EQUAL(moved.get(), raw);
+    }
+
+    BOOST_CHECK_EQUAL(alloc.statistics().outstanding, 0u);
+    BOOST_CHECK_EQUAL(alloc.allocate(16, 8), raw);
+    alloc.deallocate(raw);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_numa_aware)
+{
+    BOOST_CHECK_GE(glados::detail::numa_nodes(), 1u);
+    BOOST_CHECK_LT(glados::detail::current_numa_node(), glados::detail::numa_nodes());
+
+    auto policy = glados::pool_policy{};
+    policy.numa_aware = true;
+
+    auto alloc = host_pool<glados::memory_layout::pointer_3D>{0, policy};
+    alloc.reserve(2, 8, 8, 8);
+
+    constexpr auto threads = 4;
+    constexpr auto rounds = 200;
+    std::atomic<int> errors{0};
+    auto workers = std::vector<std::thread>{};
+    for(auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&alloc, &errors, t]()
+        {
+            for(auto i = 0; i < rounds; ++i)
+            {
+                auto p = alloc.allocate(8, 8, 8);
+                p[0] = t;
+                p[8 * 8 * 8 - 1] = i;
+                if(p[0] != t || p[8 * 8 * 8 - 1] != i)
+                    ++errors;
+                alloc.deallocate(p);
+            }
+        });
+    }
+
+    for(auto&& w : workers)
+        w.join();
+
+    BOOST_CHECK_EQUAL(errors.load(), 0);
+
+    auto stats = alloc.statistics();
+    BOOST_CHECK_EQUAL(stats.outstanding, 0u);
+    BOOST_CHECK_EQUAL(stats.hits + stats.misses, std::size_t{threads * rounds});
+    BOOST_CHECK_LE(stats.high_water, std::size_t{threads + 2});
+
+    alloc.release();
+    BOOST_CHECK_EQUAL(alloc.statistics().idle_buffers, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_numa_aware_keeps_objects)
+{
+    static_assert(glados::detail::has_anonymous_memory<glados::generic::allocator<int, glados::memory_layout::pointer_1D>>::value, "");
+    static_assert(!glados::detail::has_anonymous_memory<glados::generic::file_allocator<int, glados::memory_layout::pointer_1D>>::value, "");
+
+    using string_alloc = glados::generic::allocator<std::string, glados::memory_layout::pointer_1D>;
+
+    auto policy = glados::pool_policy{};
+    policy.numa_aware = true;
+
+    // constructed elements must survive first-touching
+    auto alloc = glados::pool_allocator<std::string, glados::memory_layout::pointer_1D, string_alloc>{0, policy};
+    alloc.reserve(2, 4096, true);
+
+    auto p = alloc.allocate(4096);
+    BOOST_CHECK(p[0].empty());
+    BOOST_CHECK(p[4095].empty());
+    p[0] = "a string too long for the small buffer optimization";
+    BOOST_CHECK_EQUAL(p[0].size(), 51u);
+    alloc.deallocate(p);
+    alloc.release();
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_shared_budget)
+{
+    constexpr auto bytes = 256 * sizeof(int);
+    glados::memory_budget budget{4 * bytes};
+
+    auto policy = glados::pool_policy{};
+    policy.budget = &budget;
+
+    auto a = host_pool<glados::memory_layout::pointer_1D>{0, policy};
+    auto b = host_pool<glados::memory_layout::pointer_1D>{0, policy};
+
+    // a hoards three idle buffers
+    auto p1 = a.allocate(256);
+    auto p2 = a.allocate(256);
+    auto p3 = a.allocate(256);
+    a.deallocate(p1);
+    a.deallocate(p2);
+    a.deallocate(p3);
+    BOOST_CHECK_EQUAL(budget.used(), 3 * bytes);
+
+    // b needs two buffers, one of a's idle buffers is reclaimed for the second
+    auto q1 = b.allocate(256);
+    auto q2 = b.allocate(256);
+    BOOST_CHECK_EQUAL(budget.used(), 4 * bytes);
+    BOOST_CHECK_EQUAL(a.statistics().idle_buffers, 2u);
+
+    // nothing idle is left to reclaim once a's buffers are in use
+    auto r1 = a.allocate(256);
+    auto r2 = a.allocate(256);
+    BOOST_CHECK(!budget.try_acquire_for(bytes, std::chrono::milliseconds{20}));
+
+    std::atomic<bool> done{false};
+    auto waiter = std::thread{[&b, &done]()
+    {
+        auto q3 = b.allocate(256);
+        done = true;
+        b.deallocate(q3);
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    BOOST_CHECK(!done.load());
+    BOOST_CHECK_EQUAL(budget.waiting(), 1u);
+
+    // a's returned buffer is idle now and can be handed over
+    a.deallocate(r1);
+    waiter.join();
+    BOOST_CHECK(done.load());
+
+    a.deallocate(r2);
+    b.deallocate(q1);
+    b.deallocate(q2);
+    a.release();
+    b.release();
+    BOOST_CHECK_EQUAL(budget.used(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(pool_alloc_budget_follows_moves)
+{
+    using pool_type = host_pool<glados::memory_layout::pointer_1D>;
+    static_assert(std::is_nothrow_move_constructible<pool_type>::value, "");
+    static_assert(std::is_nothrow_move_assignable<pool_type>::value, "");
+
+    constexpr auto bytes = 256 * sizeof(int);
+    glados::memory_budget budget{2 * bytes};
+
+    auto policy = glados::pool_policy{};
+    policy.budget = &budget;
+
+    auto a = pool_type{0, policy};
+    a.deallocate(a.allocate(256));
+
+    // the idle buffer travels through a move construction and a move assignment
+    auto moved = std::move(a);
+    auto b = pool_type{0, policy};
+    b = std::move(moved);
+    BOOST_CHECK_EQUAL(b.statistics().idle_buffers, 1u);
+
+    // the budget reclaims it from its final owner
+    auto c = pool_type{0, policy};
+    auto q1 = c.allocate(256);
+    auto q2 = c.allocate(256);
+    BOOST_CHECK_EQUAL(b.statistics().idle_buffers, 0u);
+    BOOST_CHECK_EQUAL(budget.used(), 2 * bytes);
+
+    c.deallocate(q1);
+    c.deallocate(q2);
+    c.release();
+    BOOST_CHECK_EQUAL(budget.used(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(input_side_charges_budget)
+{
+    glados::memory_budget budget{1024};
+    auto in = glados::pipeline::input_side<std::vector<char>>{};
+    in.set_memory_budget(&budget, [](const std::vector<char>& v) { return v.size(); });
+
+    in.input(std::vector<char>(600));
+    BOOST_CHECK_EQUAL(budget.used(), 600u);
+    BOOST_CHECK(!budget.try_acquire(600));
+
+    auto producer = std::thread{[&in]() { in.input(std::vector<char>(500)); }};
+    BOOST_CHECK_EQUAL(in.take().size(), 600u);
+    producer.join();
+    BOOST_CHECK_EQUAL(in.take().size(), 500u);
+
+    BOOST_CHECK_EQUAL(budget.used(), 0u);
+    BOOST_CHECK_THROW(budget.acquire(2048), std::bad_alloc);
+
+    // queued items keep the charges they were given
+    in.input(std::vector<char>(100));
+    BOOST_CHECK_THROW(in.set_memory_budget(nullptr, nullptr), std::logic_error);
+    BOOST_CHECK_EQUAL(in.take().size(), 100u);
+    BOOST_CHECK_EQUAL(budget.used(), 0u);
+}
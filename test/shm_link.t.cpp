@@ -0,0 +1,339 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BOOST_TEST_MODULE ShmLink
+#include <boost/test/unit_test.hpp>
+
+#include <glados/pipeline/pipeline.h>
+#include <glados/pipeline/shm_link.h>
+
+namespace
+{
+    auto ring_name(const char* suffix) -> std::string
+    {
+        return "/glados_test_" + std::to_string(::getpid()) + "_" + suffix;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_in_process)
+{
+    constexpr auto items = 1000u;
+    constexpr auto capacity = 256u;
+    auto name = ring_name("threads");
+
+    glados::pipeline::shm_output_side<int> out{name, 4, capacity};
+    glados::pipeline::shm_input_side<int> in{name};
+
+    auto producer = std::thread{[&]()
+    {
+        for(auto i = 0u; i < items; ++i)
+        {
+            auto buf = out.acquire();
+            buf.resize(i % capacity + 1);
+            std::fill(buf.data(), buf.data() + buf.size(), static_cast<int>(i));
+            out.output(std::move(buf));
+        }
+    }};
+
+    auto ok = true;
+    auto held = std::vector<glados::pipeline::shm_buffer<int>>{};
+    for(auto i = 0u; i < items; ++i)
+    {
+        auto buf = in.take();
+        ok = ok && (buf.size() == i % capacity + 1);
+        ok = ok && std::all_of(buf.data(), buf.data() + buf.size(), [i](int v) { return v == static_cast<int>(i); });
+
+        // return slots out of order
+        held.push_back(std::move(buf));
+        if(held.size() == 2)
+        {
+            held.back().reset();
+            held.front().reset();
+            held.clear();
+        }
+    }
+    held.clear();
+
+    producer.join();
+    BOOST_CHECK(ok);
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_cancelled_slots_are_skipped)
+{
+    auto name = ring_name("cancel");
+    glados::pipeline::shm_output_side<int> out{name, 2, 16};
+    glados::pipeline::shm_input_side<int> in{name};
+
+    {
+        auto dropped = out.acquire();
+    }
+
+    auto buf = out.acquire();
+    buf.resize(1);
+    buf[0] = 42;
+    out.output(std::move(buf));
+
+    auto t = in.take();
+    BOOST_CHECK_EQUAL(t.size(), 1u);
+    BOOST_CHECK_EQUAL(t[0], 42);
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_consumer_gone)
+{
+    auto name = ring_name("gone");
+    glados::pipeline::shm_output_side<int> out{name, 2, 16};
+
+    auto a = out.acquire();
+    auto b = out.acquire();
+    {
+        glados::pipeline::shm_input_side<int> in{name};
+    }
+    BOOST_CHECK_THROW(out.acquire(), std::runtime_error);
+
+    auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    BOOST_REQUIRE(fd != -1);
+    auto base = ::mmap(nullptr, sizeof(glados::pipeline::detail::shm_header), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    BOOST_REQUIRE(base != MAP_FAILED);
+    auto h = static_cast<const glados::pipeline::detail::shm_header*>(base);
+
+    // the failed acquire() must leave the slots still held alone
+    BOOST_CHECK_EQUAL(h->head.load(), 0u);
+    a.resize(1);
+    a[0] = 1;
+    out.output(std::move(a));
+    BOOST_CHECK_EQUAL(h->head.load(), 1u);
+    b.reset();
+    BOOST_CHECK_EQUAL(h->head.load(), 2u);
+
+    ::munmap(base, sizeof(glados::pipeline::detail::shm_header));
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_across_processes)
+{
+    constexpr auto items = 500u;
+    constexpr auto capacity = 1024u;
+    auto name = ring_name("fork");
+
+    glados::pipeline::shm_output_side<float> out{name, 8, capacity};
+
+    auto pid = ::fork();
+    BOOST_REQUIRE(pid != -1);
+
+    if(pid == 0)
+    {
+        auto status = EXIT_SUCCESS;
+        try
+        {
+            glados::pipeline::shm_input_side<float> in{name};
+            for(auto i = 0u; i < items; ++i)
+            {
+                auto buf = in.take();
+                if(buf.size() != capacity || buf[capacity - 1] != static_cast<float>(i))
+                    status = EXIT_FAILURE;
+            }
+        }
+        catch(...)
+        {
+            status = EXIT_FAILURE;
+        }
+        ::_exit(status);
+    }
+
+    for(auto i = 0u; i < items; ++i)
+    {
+        auto buf = out.acquire();
+        std::fill(buf.data(), buf.data() + buf.size(), static_cast<float>(i));
+        out.output(std::move(buf));
+    }
+
+    auto status = 0;
+    ::waitpid(pid, &status, 0);
+    BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_existing_ring_is_kept)
+{
+    auto name = ring_name("exists");
+    glados::pipeline::shm_output_side<int> out{name, 2, 16};
+    glados::pipeline::shm_input_side<int> in{name};
+
+    auto err = 0;
+    try
+    {
+        glados::pipeline::shm_output_side<int> second{name, 2, 16};
+    }
+    catch(const std::system_error& e)
+    {
+        err = e.code().value();
+    }
+    BOOST_CHECK_EQUAL(err, EEXIST);
+
+    // the first ring is still usable
+    auto buf = out.acquire();
+    buf.resize(1);
+    buf[0] = 7;
+    out.output(std::move(buf));
+    BOOST_CHECK_EQUAL(in.take()[0], 7);
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_end_of_stream)
+{
+    auto name = ring_name("eos");
+    glados::pipeline::shm_output_side<int> out{name, 4, 16};
+    glados::pipeline::shm_input_side<int> in{name};
+
+    auto buf = out.acquire();
+    buf.resize(1);
+    buf[0] = 1;
+    out.output(std::move(buf));
+    out.output(glados::pipeline::shm_buffer<int>{});
+
+    // slots published before the end of the stream are still delivered
+    auto t = in.take();
+    BOOST_REQUIRE(t);
+    BOOST_CHECK_EQUAL(t[0], 1);
+    BOOST_CHECK(!in.take());
+}
+
+namespace
+{
+    class shm_source
+    {
+        public:
+            using input_type = void;
+            using output_type = glados::pipeline::shm_buffer<int>;
+
+            shm_source(glados::pipeline::shm_output_side<int>& ring) noexcept : ring_{&ring} {}
+
+            auto run() -> void
+            {
+                for(auto i = 0; i < 100; ++i)
+                {
+                    auto buf = ring_->acquire();
+                    buf.resize(1);
+                    buf[0] = i;
+                    output_(std::move(buf));
+                }
+                output_(output_type{});
+            }
+
+            auto set_output_function(std::function<void(output_type)> f) noexcept -> void { output_ = f; }
+
+        private:
+            glados::pipeline::shm_output_side<int>* ring_;
+            std::function<void(output_type)> output_;
+    };
+
+    class shm_sink
+    {
+        public:
+            using input_type = glados::pipeline::shm_buffer<int>;
+            using output_type = void;
+
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto buf = input_();
+                    if(!buf)
+                        break;
+                    sum += buf[0];
+                }
+            }
+
+            auto set_input_function(std::function<input_type(void)> f) noexcept -> void { input_ = f; }
+
+            int sum = 0;
+
+        private:
+            std::function<input_type(void)> input_;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_connected_to_stages)
+{
+    auto name = ring_name("stages");
+    glados::pipeline::shm_output_side<int> out{name, 4, 1};
+    glados::pipeline::shm_input_side<int> in{name};
+
+    auto p = glados::pipeline::pipeline{};
+    auto src = p.make_stage<shm_source>(out);
+    auto snk = p.make_stage<shm_sink>();
+    p.connect(src, out);
+    p.connect(in, snk);
+    p.run(src, out, in, snk);
+    p.wait();
+
+    BOOST_CHECK_EQUAL(snk.sum, 4950);
+}
+
+BOOST_AUTO_TEST_CASE(shm_link_producer_death)
+{
+    auto name = ring_name("death");
+
+    auto pid = ::fork();
+    BOOST_REQUIRE(pid != -1);
+
+    if(pid == 0)
+    {
+        // publish one slot and die without closing the ring
+        glados::pipeline::shm_output_side<int> out{name, 2, 1};
+        auto buf = out.acquire();
+        buf[0] = 3;
+        out.output(std::move(buf));
+        ::usleep(200000);
+        ::_exit(EXIT_SUCCESS);
+    }
+
+    glados::pipeline::shm_input_side<int> in{name};
+    auto t = in.take();
+    BOOST_REQUIRE(t);
+    BOOST_CHECK_EQUAL(t[0], 3);
+    t.reset();
+
+    // waitpid reaps the child so that the death is visible
+    auto status = 0;
+    ::waitpid(pid, &status, 0);
+    BOOST_CHECK(!in.take());
+
+    glados::pipeline::shm_output_side<int>::remove(name);
+}
@@ -0,0 +1,492 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define BOOST_TEST_MODULE TaskQueue
+#include <boost/test/unit_test.hpp>
+
+#include <unistd.h>
+
+#include <glados/pipeline/pipeline.h>
+#include <glados/pipeline/streaming_task_queue.h>
+#include <glados/pipeline/task_queue.h>
+
+namespace
+{
+    struct task
+    {
+        int id;
+    };
+
+    class counting_stage
+    {
+        public:
+            counting_stage(std::atomic<int>& sum) noexcept : sum_{&sum} {}
+
+            auto run() -> void { *sum_ += task_.id; }
+            auto assign_task(task t) noexcept -> void { task_ = t; }
+
+        private:
+            std::atomic<int>* sum_;
+            task task_;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_try_pop_and_bulk)
+{
+    glados::pipeline::task_queue<int> q;
+
+    auto t = 0;
+    BOOST_CHECK(!q.try_pop(t));
+    BOOST_CHECK_THROW(q.pop(), std::out_of_range);
+
+    auto in = std::vector<int>{1, 2, 3, 4, 5};
+    q.push_bulk(std::begin(in), std::end(in));
+    q.push(6);
+    BOOST_CHECK_EQUAL(q.size(), 6u);
+
+    auto out = std::vector<int>{};
+    BOOST_CHECK_EQUAL(q.pop_bulk(std::back_inserter(out), 4), 4u);
+    BOOST_CHECK(q.try_pop(t));
+    BOOST_CHECK_EQUAL(t, 5);
+    BOOST_CHECK_EQUAL(q.pop(), 6);
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK((out == std::vector<int>{1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_concurrent_producers_and_consumers)
+{
+    constexpr auto producers = 4;
+    constexpr auto consumers = 4;
+    constexpr auto per_producer = 20000;
+
+    glados::pipeline::task_queue<int> q;
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+
+    auto threads = std::vector<std::thread>{};
+    for(auto c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&]()
+        {
+            auto t = 0;
+            while(q.pop_wait(t))
+            {
+                sum += t;
+                ++count;
+            }
+        });
+    }
+
+    auto producer_threads = std::vector<std::thread>{};
+    for(auto p = 0; p < producers; ++p)
+    {
+        producer_threads.emplace_back([&q, p]()
+        {
+            auto batch = std::vector<int>{};
+            for(auto i = 1; i <= per_producer; ++i)
+            {
+                if(p % 2 == 0)
+                    q.push(i);
+                else
+                {
+                    batch.push_back(i);
+                    if(batch.size() == 64 || i == per_producer)
+                    {
+                        q.push_bulk(std::begin(batch), std::end(batch));
+                        batch.clear();
+                    }
+                }
+            }
+        });
+    }
+
+    for(auto&& t : producer_threads)
+        t.join();
+    q.close();
+    for(auto&& t : threads)
+        t.join();
+
+    BOOST_CHECK_EQUAL(count.load(), producers * per_producer);
+    BOOST_CHECK_EQUAL(sum.load(), static_cast<long long>(producers) * per_producer * (per_producer + 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_shared_by_task_pipelines)
+{
+    auto tasks = std::queue<task>{};
+    for(auto i = 1; i <= 100; ++i)
+        tasks.push(task{i});
+
+    glados::pipeline::task_queue<task> q{tasks};
+    std::atomic<int> sum{0};
+
+    auto a = counting_stage{sum};
+    auto b = counting_stage{sum};
+    glados::pipeline::task_pipeline<task> p1{&q};
+    glados::pipeline::task_pipeline<task> p2{&q};
+
+    p1.run(a);
+    p2.run(b);
+    p1.wait();
+    p2.wait();
+
+    BOOST_CHECK_EQUAL(sum.load(), 5050);
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_weighted_priorities)
+{
+    glados::pipeline::task_queue<int, glados::pipeline::weighted_scheduler> q;
+
+    q.push(1, 0);
+    q.push(2, 5);
+    q.push(3, 0);
+    auto urgent = std::vector<std::pair<int, int>>{{4, 5}, {5, 9}};
+    q.push_bulk(std::begin(urgent), std::end(urgent));
+
+    BOOST_CHECK_EQUAL(q.size(), 5u);
+
+    // equal weights keep their insertion order
+    auto out = std::vector<int>{};
+    BOOST_CHECK_EQUAL(q.pop_bulk(std::back_inserter(out), 10), 5u);
+    BOOST_CHECK((out == std::vector<int>{5, 2, 4, 1, 3}));
+
+    q.close();
+    auto t = 0;
+    BOOST_CHECK(!q.pop_wait(t));
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_deadline_pipeline)
+{
+    using queue_type = glados::pipeline::task_queue<task, glados::pipeline::deadline_scheduler>;
+    using clock = std::chrono::steady_clock;
+
+    queue_type q;
+    auto now = clock::now();
+
+    // reprocessing jobs with a relaxed deadline, then an urgent scan
+    for(auto i = 1; i <= 10; ++i)
+        q.push(task{i}, now + std::chrono::hours{8});
+    q.push(task{100}, now + std::chrono::seconds{1});
+    q.close();
+
+    auto order = std::vector<int>{};
+    class recording_stage
+    {
+        public:
+            recording_stage(std::vector<int>& order) noexcept : order_{&order} {}
+
+            auto run() -> void { order_->push_back(task_.id); }
+            auto assign_task(task t) noexcept -> void { task_ = t; }
+
+        private:
+            std::vector<int>* order_;
+            task task_;
+    };
+
+    auto s = recording_stage{order};
+    glados::pipeline::task_pipeline<task, queue_type> p{&q};
+    p.run(s);
+    p.wait();
+
+    BOOST_CHECK((order == std::vector<int>{100, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+BOOST_AUTO_TEST_CASE(streaming_task_queue_generator)
+{
+    using queue_type = glados::pipeline::streaming_task_queue<task>;
+
+    auto next = 0;
+    auto generator = [&next](task& t)
+    {
+        if(next == 10000)
+            return false;
+        t.id = ++next;
+        return true;
+    };
+
+    queue_type q{generator, 16};
+    std::atomic<int> sum{0};
+
+    auto a = counting_stage{sum};
+    auto b = counting_stage{sum};
+    glados::pipeline::task_pipeline<task, queue_type> p1{&q};
+    glados::pipeline::task_pipeline<task, queue_type> p2{&q};
+
+    p1.run(a);
+    p2.run(b);
+    while(!q.empty())
+        BOOST_CHECK_LE(q.size(), 16u);
+    p1.wait();
+    p2.wait();
+
+    BOOST_CHECK_EQUAL(sum.load(), 10000 * 10001 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(streaming_task_queue_generator_error)
+{
+    auto next = 0;
+    glados::pipeline::streaming_task_queue<int> q{[&next](int& t)
+    {
+        if(next == 3)
+            throw std::runtime_error{"broken record"};
+        t = next++;
+        return true;
+    }};
+
+    auto t = 0;
+    for(auto i = 0; i < 3; ++i)
+    {
+        BOOST_CHECK(q.pop_wait(t));
+        BOOST_CHECK_EQUAL(t, i);
+    }
+    BOOST_CHECK_THROW(q.pop_wait(t), std::runtime_error);
+    BOOST_CHECK(!q.pop_wait(t));
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(streaming_task_queue_mapped_records)
+{
+    struct record
+    {
+        int id;
+        float angle;
+    };
+
+    auto path = std::string{"/tmp/glados_task_records"} + std::to_string(::getpid());
+    auto file = std::fopen(path.c_str(), "wb");
+    BOOST_REQUIRE(file != nullptr);
+    for(auto i = 1; i <= 5000; ++i)
+    {
+        auto r = record{i, 0.5f * static_cast<float>(i)};
+        std::fwrite(&r, sizeof(r), 1, file);
+    }
+    std::fclose(file);
+
+    // release every page immediately to exercise the read-behind path
+    auto reader = glados::pipeline::mapped_record_reader<record>{path, 1};
+    BOOST_CHECK_EQUAL(reader.records(), 5000u);
+    std::remove(path.c_str());
+
+    auto shared = std::make_shared<decltype(reader)>(std::move(reader));
+    glados::pipeline::streaming_task_queue<task> q{[shared](task& t)
+    {
+        auto r = record{};
+        if(!(*shared)(r))
+            return false;
+        t.id = r.id;
+        return true;
+    }, 64};
+
+    auto sum = 0;
+    auto t = task{};
+    while(q.pop_wait(t))
+        sum += t.id;
+
+    BOOST_CHECK_EQUAL(sum, 5000 * 5001 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_dependencies)
+{
+    using queue_type = glados::pipeline::task_queue<task, glados::pipeline::dependency_scheduler<int>>;
+    queue_type q{[](const task& t) { return t.id; }};
+
+    // 3 needs 1 and 2, 4 needs 3; 5 depends on 6 which is pushed later
+    q.push(task{3}, {1, 2});
+    q.push(task{4}, {3});
+    q.push(task{1});
+    q.push(task{5}, {6});
+    q.push(task{2}, {1, 1});
+    BOOST_CHECK_EQUAL(q.size(), 5u);
+    BOOST_CHECK_EQUAL(q.ready(), 1u);
+
+    // ids are unique among pending tasks
+    BOOST_CHECK_THROW(q.push(task{4}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(q.size(), 5u);
+
+    auto t = task{};
+    BOOST_CHECK(q.try_pop(t));
+    BOOST_CHECK_EQUAL(t.id, 1);
+    BOOST_CHECK(!q.try_pop(t));
+
+    q.complete(t);
+    BOOST_CHECK(q.try_pop(t));
+    BOOST_CHECK_EQUAL(t.id, 2);
+    q.complete(t);
+    BOOST_CHECK(q.try_pop(t));
+    BOOST_CHECK_EQUAL(t.id, 3);
+
+    // a failed prerequisite keeps its dependents blocked
+    q.abandon(t);
+    q.close();
+    BOOST_CHECK_THROW(q.pop_wait(t), std::logic_error);
+
+    q.mark_done(3);
+    q.mark_done(6);
+    auto out = std::vector<task>{};
+    BOOST_CHECK_EQUAL(q.pop_bulk(std::back_inserter(out), 10), 2u);
+    BOOST_CHECK_EQUAL(out[0].id, 4);
+    BOOST_CHECK_EQUAL(out[1].id, 5);
+    q.complete(out[0]);
+    q.complete(out[1]);
+    BOOST_CHECK(!q.pop_wait(t));
+
+    // only running tasks can be completed or abandoned, and only once
+    BOOST_CHECK_THROW(q.complete(out[0]), std::logic_error);
+    BOOST_CHECK_THROW(q.abandon(task{9}), std::logic_error);
+
+    // completed ids satisfy later pushes until they are forgotten
+    q.push(task{7}, {1});
+    q.forget(1);
+    q.push(task{8}, {1});
+    BOOST_CHECK_EQUAL(q.ready(), 1u);
+    BOOST_CHECK_EQUAL(q.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_dependency_pipelines)
+{
+    using queue_type = glados::pipeline::task_queue<task, glados::pipeline::dependency_scheduler<int>>;
+    queue_type q{[](const task& t) { return t.id; }};
+
+    // tasks 1 and 2 are calibrations, every other task needs one of them
+    q.push(task{1});
+    q.push(task{2});
+    for(auto i = 3; i <= 40; ++i)
+        q.push(task{i}, {1 + i % 2});
+    q.close();
+
+    class recording_stage
+    {
+        public:
+            recording_stage(std::mutex& m, std::vector<int>& finished) noexcept : mutex_{&m}, finished_{&finished} {}
+
+            auto run() -> void
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                auto&& lock = std::lock_guard<std::mutex>{*mutex_};
+                finished_->push_back(task_.id);
+            }
+
+            auto assign_task(task t) noexcept -> void { task_ = t; }
+
+        private:
+            std::mutex* mutex_;
+            std::vector<int>* finished_;
+            task task_;
+    };
+
+    std::mutex m;
+    auto finished = std::vector<int>{};
+    auto a = recording_stage{m, finished};
+    auto b = recording_stage{m, finished};
+    auto c = recording_stage{m, finished};
+    glados::pipeline::task_pipeline<task, queue_type> p1{&q};
+    glados::pipeline::task_pipeline<task, queue_type> p2{&q};
+    glados::pipeline::task_pipeline<task, queue_type> p3{&q};
+
+    p1.run(a);
+    p2.run(b);
+    p3.run(c);
+    p1.wait();
+    p2.wait();
+    p3.wait();
+
+    BOOST_REQUIRE_EQUAL(finished.size(), 40u);
+    auto pos = [&finished](int id) { return std::find(std::begin(finished), std::end(finished), id) - std::begin(finished); };
+    for(auto i = 3; i <= 40; ++i)
+        BOOST_CHECK(pos(i) > pos(1 + i % 2));
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_non_default_constructible_tasks)
+{
+    struct labelled_task
+    {
+        explicit labelled_task(int i) : id{i} {}
+        int id;
+    };
+
+    glados::pipeline::task_queue<labelled_task> fifo;
+    for(auto i = 1; i <= 4; ++i)
+        fifo.push(labelled_task{i});
+
+    auto out = std::vector<labelled_task>{};
+    BOOST_CHECK_EQUAL(fifo.pop_bulk(std::back_inserter(out), 2), 2u);
+    BOOST_CHECK_EQUAL(fifo.pop().id, 3);
+    BOOST_CHECK_EQUAL(fifo.pop_wait()->id, 4);
+    fifo.close();
+    BOOST_CHECK(fifo.pop_wait() == nullptr);
+
+    using priority_queue = glados::pipeline::task_queue<labelled_task, glados::pipeline::priority_scheduler<int>>;
+    priority_queue urgent;
+    urgent.push(labelled_task{1}, 5);
+    urgent.push(labelled_task{2}, 1);
+    BOOST_CHECK_EQUAL(urgent.pop().id, 2);
+
+    using dependency_queue = glados::pipeline::task_queue<labelled_task, glados::pipeline::dependency_scheduler<int>>;
+    dependency_queue q{[](const labelled_task& t) { return t.id; }};
+    q.push(labelled_task{1});
+    for(auto i = 2; i <= 20; ++i)
+        q.push(labelled_task{i}, {1});
+    q.close();
+
+    class summing_stage
+    {
+        public:
+            summing_stage(std::atomic<int>& sum) noexcept : sum_{&sum}, id_{0} {}
+
+            auto run() -> void { *sum_ += id_; }
+            auto assign_task(const labelled_task& t) noexcept -> void { id_ = t.id; }
+
+        private:
+            std::atomic<int>* sum_;
+            int id_;
+    };
+
+    std::atomic<int> sum{0};
+    auto a = summing_stage{sum};
+    auto b = summing_stage{sum};
+    glados::pipeline::task_pipeline<labelled_task, dependency_queue> p1{&q};
+    glados::pipeline::task_pipeline<labelled_task, dependency_queue> p2{&q};
+
+    p1.run(a);
+    p2.run(b);
+    p1.wait();
+    p2.wait();
+
+    BOOST_CHECK_EQUAL(sum.load(), 210);
+    BOOST_CHECK(q.empty());
+}
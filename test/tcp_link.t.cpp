@@ -0,0 +1,287 @@
+/*
+ * This file is part of the GLADOS library.
+ *
+ * Copyright (C) 2016 Helmholtz-Zentrum Dresden-Rossendorf
+ *
+ * GLADOS is free software: You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLADOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GLADOS. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Date: 18 October 2026
+ * Authors: Jan Stephan <j.stephan@hzdr.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE TcpLink
+#include <boost/test/unit_test.hpp>
+
+#include <glados/pipeline/pipeline.h>
+#include <glados/pipeline/tcp_link.h>
+
+namespace
+{
+    struct projection_header
+    {
+        std::uint32_t index;
+        float angle;
+    };
+
+    struct labelled
+    {
+        std::string label;
+    };
+}
+
+namespace glados
+{
+    namespace pipeline
+    {
+        template <>
+        struct serializer<labelled>
+        {
+            static auto size(const labelled& l) noexcept -> std::size_t { return l.label.size(); }
+            static auto write(const labelled& l, unsigned char* dst) noexcept -> void { std::memcpy(dst, l.label.data(), l.label.size()); }
+            static auto read(const unsigned char* src, std::size_t n) -> labelled { return labelled{std::string(reinterpret_cast<const char*>(src), n)}; }
+        };
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tcp_link_loopback_vectors)
+{
+    constexpr auto items = 2000u;
+
+    glados::pipeline::tcp_input_side<std::vector<float>> in{0, 3, 8};
+    auto port = in.port();
+
+    auto sender = std::thread{[port]()
+    {
+        glados::pipeline::tcp_output_side<std::vector<float>> out{"localhost", port, 3, 4};
+        for(auto i = 0u; i < items; ++i)
+            out.output(std::vector<float>(i % 512, static_cast<float>(i)));
+    }};
+
+    auto ok = true;
+    for(auto i = 0u; i < items; ++i)
+    {
+        auto v = in.take();
+        ok = ok && (v.size() == i % 512);
+        ok = ok && std::all_of(std::begin(v), std::end(v), [i](float f) { return f == static_cast<float>(i); });
+    }
+
+    sender.join();
+    BOOST_CHECK(ok);
+}
+
+BOOST_AUTO_TEST_CASE(tcp_link_loopback_custom_serializer)
+{
+    glados::pipeline::tcp_input_side<labelled> in{0, 1, 2};
+    glados::pipeline::tcp_input_side<projection_header> hin{0, 2, 4};
+
+    auto sender = std::thread{[&]()
+    {
+        glados::pipeline::tcp_output_side<labelled> out{"127.0.0.1", in.port()};
+        glados::pipeline::tcp_output_side<projection_header> hout{"127.0.0.1", hin.port(), 2};
+        for(auto i = 0u; i < 10u; ++i)
+        {
+            out.output(labelled{"projection " + std::to_string(i)});
+            hout.output(projection_header{i, 0.5f * static_cast<float>(i)});
+        }
+    }};
+
+    for(auto i = 0u; i < 10u; ++i)
+    {
+        BOOST_CHECK_EQUAL(in.take().label, "projection " + std::to_string(i));
+        auto h = hin.take();
+        BOOST_CHECK_EQUAL(h.index, i);
+        BOOST_CHECK_EQUAL(h.angle, 0.5f * static_cast<float>(i));
+    }
+
+    sender.join();
+
+    // labelled has no operator==, the end-of-stream item is only produced here
+    BOOST_CHECK(in.take().label.empty());
+}
+
+BOOST_AUTO_TEST_CASE(tcp_link_concurrent_producers)
+{
+    constexpr auto producers = 4;
+    constexpr auto per_producer = 500;
+
+    glados::pipeline::tcp_input_side<int> in{0, 3, 6};
+    auto port = in.port();
+
+    auto sender = std::thread{[port]()
+    {
+        glados::pipeline::tcp_output_side<int> out{"localhost", port, 3};
+        auto threads = std::vector<std::thread>{};
+        for(auto p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&out]()
+            {
+                for(auto i = 1; i <= per_producer; ++i)
+                    out.output(int{i});
+            });
+        }
+        for(auto&& t : threads)
+            t.join();
+    }};
+
+    auto sum = 0;
+    for(auto i = 0; i < producers * per_producer; ++i)
+        sum += in.take();
+
+    sender.join();
+    BOOST_CHECK_EQUAL(sum, producers * per_producer * (per_producer + 1) / 2);
+    BOOST_CHECK_EQUAL(in.take(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(tcp_link_close_without_credits)
+{
+    BOOST_CHECK_THROW((glados::pipeline::tcp_input_side<int>{0, 4, 2}), std::invalid_argument);
+
+    glados::pipeline::tcp_input_side<int> in{0, 1, 2};
+    auto port = in.port();
+    auto accepted = std::thread{[&in]() { in.accept(); }};
+
+    // the receiver never takes, so only two items can be sent
+    auto start = std::chrono::steady_clock::now();
+    {
+        glados::pipeline::tcp_output_side<int> out{"localhost", port};
+        for(auto i = 1; i <= 10; ++i)
+            out.output(int{i});
+        out.close(std::chrono::milliseconds{100});
+    }
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds{5});
+
+    accepted.join();
+}
+
+namespace
+{
+    struct frame
+    {
+        int value;
+        bool valid;
+    };
+
+    class frame_source
+    {
+        public:
+            using input_type = void;
+            using output_type = frame;
+
+            auto run() -> void
+            {
+                for(auto i = 1; i <= 100; ++i)
+                    output_(frame{i, true});
+                output_(frame{0, false});
+            }
+
+            auto set_output_function(std::function<void(output_type)> f) noexcept -> void { output_ = f; }
+
+        private:
+            std::function<void(output_type)> output_;
+    };
+
+    class frame_sink
+    {
+        public:
+            using input_type = frame;
+            using output_type = void;
+
+            auto run() -> void
+            {
+                while(true)
+                {
+                    auto f = input_();
+                    if(!f.valid)
+                        break;
+                    sum += f.value;
+                }
+            }
+
+            auto set_input_function(std::function<input_type(void)> f) noexcept -> void { input_ = f; }
+
+            int sum = 0;
+
+        private:
+            std::function<input_type(void)> input_;
+    };
+}
+
+namespace glados
+{
+    namespace pipeline
+    {
+        template <>
+        struct end_of_stream<frame>
+        {
+            static auto make() noexcept -> frame { return frame{0, false}; }
+            static auto is(const frame& f) noexcept -> bool { return !f.valid; }
+        };
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tcp_link_connected_to_stages)
+{
+    glados::pipeline::tcp_input_side<frame> in{0, 2, 8};
+    auto port = in.port();
+
+    auto sender = std::thread{[port]()
+    {
+        glados::pipeline::tcp_output_side<frame> out{"localhost", port, 2};
+        auto p = glados::pipeline::pipeline{};
+        auto src = p.make_stage<frame_source>();
+        p.connect(src, out);
+        p.run(src, out);
+        p.wait();
+    }};
+
+    auto p = glados::pipeline::pipeline{};
+    auto snk = p.make_stage<frame_sink>();
+    p.connect(in, snk);
+    p.run(in, snk);
+    p.wait();
+
+    sender.join();
+    BOOST_CHECK_EQUAL(snk.sum, 5050);
+}
+
+BOOST_AUTO_TEST_CASE(tcp_link_bind_address_and_frame_limit)
+{
+    // 16 floats fit, 17 do not
+    glados::pipeline::tcp_input_side<std::vector<float>> in{"127.0.0.1", 0, 1, 4, 16 * sizeof(float)};
+    auto port = in.port();
+
+    auto sender = std::thread{[port]()
+    {
+        glados::pipeline::tcp_output_side<std::vector<float>> out{"127.0.0.1", port};
+        out.output(std::vector<float>(16, 1.f));
+        out.output(std::vector<float>(17, 2.f));
+        out.close(std::chrono::milliseconds{100});
+    }};
+
+    BOOST_CHECK_EQUAL(in.take().size(), 16u);
+    BOOST_CHECK_THROW(in.take(), std::runtime_error);
+    sender.join();
+}